@@ -0,0 +1,328 @@
+// Broadphase micro-benchmark.
+// 1. Compares the flat counting-sort SpatialGrid with the original
+//    vector-of-vectors grid at several ball counts.
+// 2. Compares the broadphase backends over a run of steps with coherent,
+//    gas-like motion (the case sweep and prune is designed for), with uniform
+//    and with mixed radii (the case the AABB tree is designed for).
+// 3. Compares the per-pair narrowphase test with the batched contact filter.
+
+#include "entities/BallStore.h"
+#include "entities/Container.h"
+#include "physics/BatchNarrowphase.h"
+#include "physics/CollisionDetector.h"
+#include "physics/DynamicAabbTree.h"
+#include "physics/GridBroadphase.h"
+#include "physics/SpatialGrid.h"
+#include "physics/SweepAndPrune.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using PairList = std::vector<std::pair<size_t, size_t>>;
+
+// The grid as it was before the counting-sort rewrite (kept here as the baseline)
+class LegacySpatialGrid {
+public:
+    LegacySpatialGrid(float cellSize, float worldWidth, float worldHeight)
+        : cellSize(cellSize)
+    {
+        gridWidth = static_cast<int>(std::ceil(worldWidth / cellSize));
+        gridHeight = static_cast<int>(std::ceil(worldHeight / cellSize));
+        cells.resize(gridWidth * gridHeight);
+    }
+
+    void clear() {
+        for (auto& cell : cells) {
+            cell.clear();
+        }
+    }
+
+    void insertBall(size_t ballIndex, float x, float y) {
+        int cx = static_cast<int>(x / cellSize);
+        int cy = static_cast<int>(y / cellSize);
+
+        if (cx >= 0 && cx < gridWidth && cy >= 0 && cy < gridHeight) {
+            cells[cy * gridWidth + cx].push_back(ballIndex);
+        }
+    }
+
+    void getPotentialCollisions(PairList& outPairs) const {
+        outPairs.clear();
+
+        const int dx[] = {1, 0, 1, -1};
+        const int dy[] = {0, 1, 1, 1};
+
+        for (int cy = 0; cy < gridHeight; ++cy) {
+            for (int cx = 0; cx < gridWidth; ++cx) {
+                const auto& cell = cells[cy * gridWidth + cx];
+
+                for (size_t i = 0; i < cell.size(); ++i) {
+                    for (size_t j = i + 1; j < cell.size(); ++j) {
+                        outPairs.emplace_back(cell[i], cell[j]);
+                    }
+                }
+
+                for (int d = 0; d < 4; ++d) {
+                    int nx = cx + dx[d];
+                    int ny = cy + dy[d];
+
+                    if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight) {
+                        const auto& neighborCell = cells[ny * gridWidth + nx];
+
+                        for (size_t i : cell) {
+                            for (size_t j : neighborCell) {
+                                outPairs.emplace_back(i, j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    float cellSize;
+    int gridWidth, gridHeight;
+    std::vector<std::vector<size_t>> cells;
+};
+
+constexpr float CELL_SIZE = 50.0f;
+constexpr float BALL_RADIUS = 7.5f;
+constexpr float BALLS_PER_CELL = 2.0f;  // Average occupancy, roughly a loose pile
+constexpr float GAS_SPEED = 150.0f;      // px/s
+constexpr float STEP = 1.0f / 120.0f;
+
+// Mixed population: mostly tiny balls with a few of the largest slider size
+constexpr float SMALL_RADIUS = 5.0f;
+constexpr float LARGE_RADIUS = 25.0f;
+constexpr float LARGE_FRACTION = 0.02f;
+constexpr float MIXED_AREA_FRACTION = 0.3f;
+
+struct World {
+    BallStore balls;
+    float width;
+    float height;
+};
+
+// Uniformly scattered balls in a 4:3 world.
+// Uniform radii: world sized for a fixed average cell occupancy.
+// Mixed radii: world sized for a fixed fraction of area covered by balls.
+World makeWorld(size_t count, uint32_t seed, bool mixedRadii = false) {
+    World world;
+    if (mixedRadii) {
+        float meanArea = 3.14159265f * ((1.0f - LARGE_FRACTION) * SMALL_RADIUS * SMALL_RADIUS
+                                        + LARGE_FRACTION * LARGE_RADIUS * LARGE_RADIUS);
+        float area = static_cast<float>(count) * meanArea / MIXED_AREA_FRACTION;
+        world.height = std::ceil(std::sqrt(area * 3.0f / 4.0f));
+    } else {
+        float cells = static_cast<float>(count) / BALLS_PER_CELL;
+        world.height = std::ceil(std::sqrt(cells * 3.0f / 4.0f)) * CELL_SIZE;
+    }
+    world.width = world.height * 4.0f / 3.0f;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xDist(0.0f, world.width);
+    std::uniform_real_distribution<float> yDist(0.0f, world.height);
+    std::uniform_real_distribution<float> angleDist(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+
+    world.balls.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Vector2D velocity = Vector2D::fromAngle(angleDist(rng), GAS_SPEED);
+        float radius = BALL_RADIUS;
+        if (mixedRadii) {
+            radius = unitDist(rng) < LARGE_FRACTION ? LARGE_RADIUS : SMALL_RADIUS;
+        }
+        world.balls.push(Ball(Vector2D(xDist(rng), yDist(rng)), velocity, radius, Color{255, 255, 255, 255}));
+    }
+    return world;
+}
+
+// Advance every ball one step, reflecting off the world edges
+void advance(World& world) {
+    BallStore& balls = world.balls;
+    for (size_t i = 0; i < balls.size(); ++i) {
+        balls.x[i] += balls.vx[i] * STEP;
+        balls.y[i] += balls.vy[i] * STEP;
+        if (balls.x[i] < 0.0f || balls.x[i] > world.width) {
+            balls.vx[i] = -balls.vx[i];
+        }
+        if (balls.y[i] < 0.0f || balls.y[i] > world.height) {
+            balls.vy[i] = -balls.vy[i];
+        }
+    }
+}
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void runCase(size_t count, int iterations) {
+    World world = makeWorld(count, 12345u);
+    const BallStore& balls = world.balls;
+
+    LegacySpatialGrid legacy(CELL_SIZE, world.width, world.height);
+    SpatialGrid flat(CELL_SIZE, world.width, world.height);
+    PairList legacyPairs;
+    PairList flatPairs;
+
+    // Warm-up so both grids run with their buffers already sized
+    legacy.clear();
+    for (size_t i = 0; i < balls.size(); ++i) {
+        legacy.insertBall(i, balls.x[i], balls.y[i]);
+    }
+    legacy.getPotentialCollisions(legacyPairs);
+    flat.build(balls);
+    flat.getPotentialCollisions(balls, flatPairs);
+
+    double legacyBest = 1e30;
+    double flatBest = 1e30;
+    for (int it = 0; it < iterations; ++it) {
+        Clock::time_point start = Clock::now();
+        legacy.clear();
+        for (size_t i = 0; i < balls.size(); ++i) {
+            legacy.insertBall(i, balls.x[i], balls.y[i]);
+        }
+        legacy.getPotentialCollisions(legacyPairs);
+        legacyBest = std::min(legacyBest, elapsedMs(start));
+
+        start = Clock::now();
+        flat.build(balls);
+        flat.getPotentialCollisions(balls, flatPairs);
+        flatBest = std::min(flatBest, elapsedMs(start));
+    }
+
+    std::printf("%9zu  %12.3f  %12.3f  %7.2fx  %12zu%s\n",
+        count, legacyBest, flatBest, legacyBest / flatBest, flatPairs.size(),
+        legacyPairs.size() == flatPairs.size() ? "" : "  (pair count mismatch!)");
+}
+
+// Pairs whose circles actually overlap
+size_t countContacts(const BallStore& balls, const PairList& pairs) {
+    size_t contacts = 0;
+    for (const auto& pair : pairs) {
+        float dx = balls.x[pair.second] - balls.x[pair.first];
+        float dy = balls.y[pair.second] - balls.y[pair.first];
+        float r = balls.radius[pair.first] + balls.radius[pair.second];
+        if (dx * dx + dy * dy < r * r) {
+            ++contacts;
+        }
+    }
+    return contacts;
+}
+
+// Mean time per step and pair count of every broadphase backend over a run of coherent motion
+void runMotionCase(size_t count, int steps, bool mixedRadii) {
+    World world = makeWorld(count, 6789u, mixedRadii);
+    Container container(Vector2D(world.width * 0.5f, world.height * 0.5f), world.width * 0.5f, 0.0f);
+
+    GridBroadphase grid;
+    SweepAndPrune sap;
+    DynamicAabbTree tree;
+    IBroadphase* backends[] = {&grid, &sap, &tree};
+    constexpr int BACKEND_COUNT = 3;
+    double totalMs[BACKEND_COUNT] = {};
+    size_t pairCount[BACKEND_COUNT] = {};
+    size_t contacts = 0;
+    PairList pairs;
+
+    // First step builds the initial state (SAP sorts, the tree inserts every leaf)
+    for (IBroadphase* backend : backends) {
+        backend->findPairs(world.balls, container, pairs);
+    }
+
+    for (int step = 0; step < steps; ++step) {
+        advance(world);
+        for (int b = 0; b < BACKEND_COUNT; ++b) {
+            Clock::time_point start = Clock::now();
+            backends[b]->findPairs(world.balls, container, pairs);
+            totalMs[b] += elapsedMs(start);
+            pairCount[b] = pairs.size();
+        }
+        contacts = countContacts(world.balls, pairs);
+    }
+
+    std::printf("%9zu  %10.3f  %10.3f  %10.3f  %11zu  %11zu  %11zu  %11zu\n",
+        count, totalMs[0] / steps, totalMs[1] / steps, totalMs[2] / steps,
+        pairCount[0], pairCount[1], pairCount[2], contacts);
+}
+
+void printMotionHeader(const char* title) {
+    std::printf("\n%s, mean ms per step\n", title);
+    std::printf("%9s  %10s  %10s  %10s  %11s  %11s  %11s  %11s\n",
+        "balls", "grid", "sap", "tree", "grid pairs", "sap pairs", "tree pairs", "contacts");
+}
+
+// Per-pair CollisionDetector test vs the batched filter over the grid's candidates
+void runNarrowphaseCase(size_t count, int iterations) {
+    World world = makeWorld(count, 4242u);
+    const BallStore& balls = world.balls;
+
+    SpatialGrid grid(CELL_SIZE, world.width, world.height);
+    PairList pairs;
+    PairList contacts;
+    grid.build(balls);
+    grid.getPotentialCollisions(balls, pairs);
+
+    double perPairBest = 1e30;
+    double batchBest = 1e30;
+    size_t perPairContacts = 0;
+    for (int it = 0; it < iterations; ++it) {
+        Clock::time_point start = Clock::now();
+        perPairContacts = 0;
+        for (const auto& pair : pairs) {
+            if (CollisionDetector::checkBallCollision(balls, pair.first, pair.second).hasCollision) {
+                ++perPairContacts;
+            }
+        }
+        perPairBest = std::min(perPairBest, elapsedMs(start));
+
+        start = Clock::now();
+        contacts.clear();
+        BatchNarrowphase::findContacts(balls, pairs, 0.0f, contacts);
+        batchBest = std::min(batchBest, elapsedMs(start));
+    }
+
+    std::printf("%9zu  %12.3f  %12.3f  %7.2fx  %12zu  %12zu\n",
+        count, perPairBest, batchBest, perPairBest / batchBest, pairs.size(), contacts.size());
+    if (contacts.size() < perPairContacts) {
+        std::printf("  (batch filter dropped contacts!)\n");
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Grid rebuild + pair generation, best of N runs (ms)\n");
+    std::printf("%9s  %12s  %12s  %8s  %12s\n", "balls", "legacy", "flat", "speedup", "pairs");
+
+    runCase(10000, 50);
+    runCase(100000, 10);
+    runCase(1000000, 3);
+
+    printMotionHeader("Coherent gas motion, uniform radius");
+    runMotionCase(10000, 60, false);
+    runMotionCase(100000, 20, false);
+    runMotionCase(1000000, 5, false);
+
+    printMotionHeader("Coherent gas motion, mixed radii (5px / 25px)");
+    runMotionCase(10000, 60, true);
+    runMotionCase(100000, 20, true);
+    runMotionCase(1000000, 5, true);
+
+    std::printf("\nNarrowphase over grid candidates, best of N runs (ms), kernel: %s\n",
+        BatchNarrowphase::getKernelName());
+    std::printf("%9s  %12s  %12s  %8s  %12s  %12s\n", "balls", "per-pair", "batched", "speedup", "pairs", "contacts");
+    runNarrowphaseCase(10000, 50);
+    runNarrowphaseCase(100000, 10);
+    runNarrowphaseCase(1000000, 3);
+
+    return 0;
+}
@@ -0,0 +1,351 @@
+// Physics benchmark: times every stage of PhysicsEngine::update plus
+// BallManager::update on reproducible ball configurations at 1k, 10k, 100k
+// and 1M balls, and writes the results as JSON.
+//
+// Scenarios (the container grows with the ball count so densities match):
+//   gas    - uniform radius, scattered over the disc at random velocities
+//   pile   - hexagonal lattice resting on the bottom of the container
+//   ring   - concentric rings along the wall, moving tangentially
+//   mixed  - gas of mostly 5px balls with 2% 25px balls
+//
+// Usage: marble_bench [--out FILE] [--max-balls N] [--threads N]
+
+#include "core/Config.h"
+#include "entities/Container.h"
+#include "game/BallManager.h"
+#include "physics/PhysicsEngine.h"
+#include "profiling/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+constexpr float STEP = Config::FIXED_TIMESTEP;
+constexpr float BALL_RADIUS = Config::BALL_RADIUS;
+constexpr float GAS_SPEED = 150.0f;        // px/s
+constexpr float GAS_AREA_FRACTION = 0.2f;  // Fraction of the disc covered by balls
+constexpr float PILE_AREA_FRACTION = 0.4f; // Fraction of the disc the pile's lattice fills
+constexpr float RING_AREA_FRACTION = 0.35f;
+constexpr float SCREEN_MARGIN = 100.0f;    // Screen edge beyond the container
+constexpr uint32_t SEED = 20240601u;
+
+// Mixed population: mostly tiny balls with a few of the largest slider size
+constexpr float SMALL_RADIUS = 5.0f;
+constexpr float LARGE_RADIUS = 25.0f;
+constexpr float LARGE_FRACTION = 0.02f;
+
+enum class Scenario {
+    Gas,
+    Pile,
+    Ring,
+    Mixed
+};
+
+const char* getScenarioName(Scenario scenario) {
+    switch (scenario) {
+        case Scenario::Gas: return "gas";
+        case Scenario::Pile: return "pile";
+        case Scenario::Ring: return "ring";
+        case Scenario::Mixed: return "mixed";
+    }
+    return "unknown";
+}
+
+// Container radius that gives the scenario its density at this ball count
+float getContainerRadius(Scenario scenario, size_t count) {
+    float n = static_cast<float>(count);
+    switch (scenario) {
+        case Scenario::Gas:
+            return std::sqrt(n * BALL_RADIUS * BALL_RADIUS / GAS_AREA_FRACTION);
+        case Scenario::Pile: {
+            // Hexagonal lattice cell of spacing 2r has area 2 * sqrt(3) * r²
+            float latticeArea = n * 2.0f * std::sqrt(3.0f) * BALL_RADIUS * BALL_RADIUS;
+            return std::sqrt(latticeArea / (PILE_AREA_FRACTION * PI));
+        }
+        case Scenario::Ring:
+            // Balls fill the outer annulus at roughly lattice density
+            return BALL_RADIUS * std::sqrt(n / RING_AREA_FRACTION);
+        case Scenario::Mixed: {
+            float meanArea = PI * ((1.0f - LARGE_FRACTION) * SMALL_RADIUS * SMALL_RADIUS
+                                   + LARGE_FRACTION * LARGE_RADIUS * LARGE_RADIUS);
+            return std::sqrt(n * meanArea / (GAS_AREA_FRACTION * PI));
+        }
+    }
+    return 0.0f;
+}
+
+Ball makeBall(float x, float y, float vx, float vy, float radius) {
+    return Ball(Vector2D(x, y), Vector2D(vx, vy), radius, Color{255, 255, 255, 255});
+}
+
+void fillGas(BallStore& balls, const Container& container, size_t count, bool mixedRadii, std::mt19937& rng) {
+    std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * PI);
+    Vector2D center = container.getCenter();
+
+    for (size_t i = 0; i < count; ++i) {
+        float radius = BALL_RADIUS;
+        if (mixedRadii) {
+            radius = unitDist(rng) < LARGE_FRACTION ? LARGE_RADIUS : SMALL_RADIUS;
+        }
+        float angle = angleDist(rng);
+        float distance = (container.getRadius() - radius) * std::sqrt(unitDist(rng));
+        float heading = angleDist(rng);
+        balls.push(makeBall(
+            center.x + std::cos(angle) * distance,
+            center.y + std::sin(angle) * distance,
+            std::cos(heading) * GAS_SPEED,
+            std::sin(heading) * GAS_SPEED,
+            radius));
+    }
+}
+
+// Rows of a hexagonal lattice from the bottom of the disc upwards, at rest
+void fillPile(BallStore& balls, const Container& container, size_t count) {
+    Vector2D center = container.getCenter();
+    float reach = container.getRadius() - BALL_RADIUS;
+    float spacing = 2.0f * BALL_RADIUS;
+    float rowHeight = spacing * std::sqrt(3.0f) * 0.5f;
+
+    for (int row = 0; balls.size() < count; ++row) {
+        float dy = reach - row * rowHeight;
+        if (dy < -reach) {
+            break;
+        }
+        float halfWidth = std::sqrt(std::max(reach * reach - dy * dy, 0.0f));
+        float offset = (row % 2) * BALL_RADIUS;
+        for (float dx = -halfWidth + offset; dx <= halfWidth && balls.size() < count; dx += spacing) {
+            balls.push(makeBall(center.x + dx, center.y + dy, 0.0f, 0.0f, BALL_RADIUS));
+        }
+    }
+}
+
+// Concentric rings hugging the wall, all moving the same way around
+void fillRing(BallStore& balls, const Container& container, size_t count) {
+    Vector2D center = container.getCenter();
+    float spacing = 2.0f * BALL_RADIUS;
+
+    for (int ring = 0; balls.size() < count; ++ring) {
+        float ringRadius = container.getRadius() - BALL_RADIUS - ring * spacing;
+        if (ringRadius < spacing) {
+            break;
+        }
+        size_t slots = static_cast<size_t>(2.0f * PI * ringRadius / spacing);
+        for (size_t k = 0; k < slots && balls.size() < count; ++k) {
+            float angle = 2.0f * PI * static_cast<float>(k) / static_cast<float>(slots);
+            float cosA = std::cos(angle);
+            float sinA = std::sin(angle);
+            balls.push(makeBall(
+                center.x + cosA * ringRadius,
+                center.y + sinA * ringRadius,
+                -sinA * GAS_SPEED,
+                cosA * GAS_SPEED,
+                BALL_RADIUS));
+        }
+    }
+}
+
+// Stages reported, in table and JSON order
+struct Stage {
+    ProfileZone zone;
+    const char* column;
+    const char* key;
+};
+
+const Stage STAGES[] = {
+    {ProfileZone::Integration, "integr", "integration"},
+    {ProfileZone::GridBuild, "grid", "grid_build"},
+    {ProfileZone::PairGeneration, "pairs", "pair_generation"},
+    {ProfileZone::Narrowphase, "narrow", "narrowphase"},
+    {ProfileZone::Container, "contain", "container"},
+    {ProfileZone::Solver, "solver", "solver"},
+    {ProfileZone::Sleep, "sleep", "sleep"},
+    {ProfileZone::BallManager, "manager", "ball_manager"},
+};
+
+constexpr size_t STAGE_COUNT = sizeof(STAGES) / sizeof(STAGES[0]);
+
+struct CaseResult {
+    Scenario scenario;
+    size_t balls;
+    int steps;
+    float containerRadius;
+    double stageMs[STAGE_COUNT];  // Mean per measured step
+    double totalMs;
+    size_t contacts;     // After the last step
+    size_t sleeping;
+    size_t finalBalls;
+};
+
+// Measured steps per case: enough for a stable mean without making 1M balls take minutes
+int getStepCount(size_t count) {
+    if (count <= 1000) return 240;
+    if (count <= 10000) return 60;
+    if (count <= 100000) return 12;
+    return 3;
+}
+
+constexpr int WARMUP_STEPS = 2;
+
+CaseResult runCase(Scenario scenario, size_t count, size_t threads) {
+    float containerRadius = getContainerRadius(scenario, count);
+    float extent = containerRadius + SCREEN_MARGIN;
+    Vector2D center(extent, extent);
+
+    Container container(center, containerRadius, Config::CONTAINER_GAP_PERCENT * 360.0f);
+    BallManager manager(center, BALL_RADIUS);
+    PhysicsEngine physics(Config::GRAVITY);
+    physics.setThreadCount(threads);
+    physics.setSolverIterations(Config::SOLVER_ITERATIONS);
+    physics.setScreenBounds(2.0f * extent, 2.0f * extent);
+
+    // BallManager seeds rand() from the clock; reseed so respawns repeat
+    std::srand(SEED);
+    std::mt19937 rng(SEED);
+    BallStore& balls = manager.getBalls();
+    balls.reserve(count);
+    switch (scenario) {
+        case Scenario::Gas: fillGas(balls, container, count, false, rng); break;
+        case Scenario::Pile: fillPile(balls, container, count); break;
+        case Scenario::Ring: fillRing(balls, container, count); break;
+        case Scenario::Mixed: fillGas(balls, container, count, true, rng); break;
+    }
+
+    CaseResult result{scenario, balls.size(), getStepCount(count), containerRadius, {}, 0.0, 0, 0, 0};
+
+    // One profiler frame per step
+    Profiler& profiler = Profiler::instance();
+    profiler.endFrame(0.0);
+
+    for (int step = 0; step < WARMUP_STEPS + result.steps; ++step) {
+        container.update(STEP);
+        physics.update(balls, container, STEP, Config::RESTITUTION);
+        manager.update();
+        profiler.endFrame(0.0);
+
+        if (step >= WARMUP_STEPS) {
+            for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+                result.stageMs[stage] += profiler.getLastFrame(STAGES[stage].zone);
+            }
+        }
+    }
+
+    for (double& stageMs : result.stageMs) {
+        stageMs /= result.steps;
+        result.totalMs += stageMs;
+    }
+
+    result.contacts = physics.getContactCount();
+    result.sleeping = physics.getSleepingCount();
+    result.finalBalls = balls.size();
+    return result;
+}
+
+void printHeader() {
+    std::printf("%-6s %9s", "case", "balls");
+    for (const Stage& stage : STAGES) {
+        std::printf(" %9s", stage.column);
+    }
+    std::printf(" %9s\n", "total");
+}
+
+void printResult(const CaseResult& result) {
+    std::printf("%-6s %9zu", getScenarioName(result.scenario), result.balls);
+    for (double stageMs : result.stageMs) {
+        std::printf(" %9.3f", stageMs);
+    }
+    std::printf(" %9.3f\n", result.totalMs);
+    std::fflush(stdout);
+}
+
+bool writeJson(const std::string& path, const std::vector<CaseResult>& results, size_t threads) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"marble_bench\",\n");
+    std::fprintf(file, "  \"threads\": %zu,\n", threads);
+    std::fprintf(file, "  \"solver_iterations\": %d,\n", Config::SOLVER_ITERATIONS);
+    std::fprintf(file, "  \"timestep\": %.6f,\n", STEP);
+    std::fprintf(file, "  \"unit\": \"ms_per_step\",\n");
+    std::fprintf(file, "  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const CaseResult& r = results[i];
+
+        std::fprintf(file, "    {\n");
+        std::fprintf(file, "      \"scenario\": \"%s\",\n", getScenarioName(r.scenario));
+        std::fprintf(file, "      \"balls\": %zu,\n", r.balls);
+        std::fprintf(file, "      \"container_radius\": %.1f,\n", r.containerRadius);
+        std::fprintf(file, "      \"steps\": %d,\n", r.steps);
+        std::fprintf(file, "      \"stages\": {\n");
+        for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+            std::fprintf(file, "        \"%s\": %.6f%s\n",
+                STAGES[stage].key, r.stageMs[stage], stage + 1 < STAGE_COUNT ? "," : "");
+        }
+        std::fprintf(file, "      },\n");
+        std::fprintf(file, "      \"total\": %.6f,\n", r.totalMs);
+        std::fprintf(file, "      \"contacts\": %zu,\n", r.contacts);
+        std::fprintf(file, "      \"sleeping\": %zu,\n", r.sleeping);
+        std::fprintf(file, "      \"final_balls\": %zu\n", r.finalBalls);
+        std::fprintf(file, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(file, "  ]\n");
+    std::fprintf(file, "}\n");
+    return std::fclose(file) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "marble_bench.json";
+    size_t maxBalls = 1000000;
+    size_t threads = 1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--out") == 0) {
+            outPath = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--max-balls") == 0) {
+            maxBalls = std::strtoul(argv[i + 1], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            threads = std::max<size_t>(std::strtoul(argv[i + 1], nullptr, 10), 1);
+        } else {
+            std::fprintf(stderr, "Usage: %s [--out FILE] [--max-balls N] [--threads N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const size_t counts[] = {1000, 10000, 100000, 1000000};
+    const Scenario scenarios[] = {Scenario::Gas, Scenario::Pile, Scenario::Ring, Scenario::Mixed};
+
+    std::printf("PhysicsEngine::update stages + BallManager::update, mean ms per step (%zu threads)\n", threads);
+    printHeader();
+
+    std::vector<CaseResult> results;
+    for (Scenario scenario : scenarios) {
+        for (size_t count : counts) {
+            if (count > maxBalls) {
+                continue;
+            }
+            results.push_back(runCase(scenario, count, threads));
+            printResult(results.back());
+        }
+    }
+
+    if (!writeJson(outPath, results, threads)) {
+        std::fprintf(stderr, "Failed to write %s\n", outPath.c_str());
+        return 1;
+    }
+    std::printf("\nWrote %s\n", outPath.c_str());
+    return 0;
+}
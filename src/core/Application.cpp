@@ -1,12 +1,12 @@
 #include "Application.h"
 #include "Config.h"
-#include "../math/MathUtils.h"
 #include <iostream>
 
 Application::Application()
     : renderer(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT, Config::WINDOW_TITLE)
+    , snapshot(nullptr)
     , bouncinessSlider(Config::SLIDER_X, Config::SLIDER_Y, Config::SLIDER_WIDTH, Config::SLIDER_HEIGHT, 0.95f, 1.05f, Config::RESTITUTION)
-    , ballSizeSlider(Config::SIZE_SLIDER_X, Config::SIZE_SLIDER_Y, Config::SIZE_SLIDER_WIDTH, Config::SIZE_SLIDER_HEIGHT, 5.0f, 25.0f, Config::BALL_RADIUS)
+    , ballSizeSlider(Config::SIZE_SLIDER_X, Config::SIZE_SLIDER_Y, Config::SIZE_SLIDER_WIDTH, Config::SIZE_SLIDER_HEIGHT, Config::MIN_BALL_RADIUS, Config::MAX_BALL_RADIUS, Config::BALL_RADIUS)
     , holeSizeSlider(Config::HOLE_SLIDER_X, Config::HOLE_SLIDER_Y, Config::HOLE_SLIDER_WIDTH, Config::HOLE_SLIDER_HEIGHT, 0.0f, 180.0f, Config::CONTAINER_GAP_PERCENT * 360.0f)
     , respawnCountSlider(Config::RESPAWN_SLIDER_X, Config::RESPAWN_SLIDER_Y, Config::RESPAWN_SLIDER_WIDTH, Config::RESPAWN_SLIDER_HEIGHT, 0.1f, 10.0f, 2.0f)
     , gravitySlider(Config::GRAVITY_SLIDER_X, Config::GRAVITY_SLIDER_Y, Config::GRAVITY_SLIDER_WIDTH, Config::GRAVITY_SLIDER_HEIGHT, 0.0f, 20.0f, 9.8f)
@@ -19,9 +19,13 @@ Application::Application()
     , respawnRate(2.0f)
     , gravity(9.8f)
     , containerDiameter(Config::CONTAINER_RADIUS * 2.0f)
+    , physicsRate(Config::PHYSICS_RATE)
     , running(false)
     , paused(false)
-    , accumulator(0.0f)
+    , showProfiler(false)
+    , resetRequests(0)
+    , broadphaseCycleRequests(0)
+    , renderAlpha(1.0f)
 {
     // Set up reset button callback
     resetButton.setOnClick([this]() {
@@ -31,7 +35,42 @@ Application::Application()
     // Set up pause button callback
     pauseButton.setOnClick([this]() {
         paused = !paused;
+        pauseButton.setLabel(paused ? "Resume" : "Pause");
     });
+
+    // Slider labels show the current value
+    bouncinessSlider.setLabelFormatter([](float value, char* buffer, size_t size) {
+        snprintf(buffer, size, "Bounciness: %.0f%%", value * 100.0f);
+    });
+    ballSizeSlider.setLabelFormatter([](float value, char* buffer, size_t size) {
+        snprintf(buffer, size, "Ball Size: %.0fpx", value * 2.0f);
+    });
+    holeSizeSlider.setLabelFormatter([](float value, char* buffer, size_t size) {
+        snprintf(buffer, size, "Hole Size: %.0f deg", value);
+    });
+    respawnCountSlider.setLabelFormatter([](float value, char* buffer, size_t size) {
+        if (value >= 1.0f) {
+            snprintf(buffer, size, "Respawn: %dx", static_cast<int>(value));
+        } else {
+            // For rates < 1, show as "2:1" ratio format
+            snprintf(buffer, size, "Respawn: %.0f:1 balls", 1.0f / value);
+        }
+    });
+    gravitySlider.setLabelFormatter([](float value, char* buffer, size_t size) {
+        snprintf(buffer, size, "Gravity: %.1f m/s^2", value);
+    });
+    diameterSlider.setLabelFormatter([](float value, char* buffer, size_t size) {
+        snprintf(buffer, size, "Cont Diameter: %.0fpx", value);
+    });
+
+    uiPanel.addWidget(&bouncinessSlider);
+    uiPanel.addWidget(&ballSizeSlider);
+    uiPanel.addWidget(&holeSizeSlider);
+    uiPanel.addWidget(&respawnCountSlider);
+    uiPanel.addWidget(&gravitySlider);
+    uiPanel.addWidget(&diameterSlider);
+    uiPanel.addWidget(&resetButton);
+    uiPanel.addWidget(&pauseButton);
 }
 
 Application::~Application() {
@@ -45,57 +84,83 @@ bool Application::initialize() {
         return false;
     }
 
-    // Initialize circle renderer
-    circleRenderer.initialize(renderer.getSDLRenderer());
+    // Initialize circle batch (rasterizes its atlas in the background)
+    if (!circleBatch.initialize(renderer.getSDLRenderer())) {
+        std::cerr << "Failed to initialize circle batch" << std::endl;
+        return false;
+    }
 
     // Initialize text renderer
-    if (!textRenderer.initialize()) {
+    if (!textRenderer.initialize(renderer.getSDLRenderer())) {
         std::cerr << "Failed to initialize text renderer" << std::endl;
         return false;
     }
+    if (!uiPanel.initialize(renderer.getSDLRenderer())) {
+        std::cerr << "Failed to initialize UI panel" << std::endl;
+        return false;
+    }
 
-    // Initialize game state
-    gameState.initialize();
+    // Start the simulation thread (spawns the first ball)
+    postedParameters = makeParameters();
+    simulation.start(postedParameters);
+    snapshot = &simulation.acquireSnapshot();
 
     running = true;
     return true;
 }
 
 void Application::run() {
+    Tracer::instance().setThreadName("Main");
+
     while (running) {
-        time.tick();
-        float frameTime = time.getDeltaTime();
+        TraceScope frameScope("Frame", "app");
 
-        // Prevent spiral of death
-        if (frameTime > 0.25f) {
-            frameTime = 0.25f;
-        }
+        time.tick();
 
-        accumulator += frameTime;
+        // Zone times recorded since the last tick belong to the frame that just ended
+        Profiler::instance().endFrame(time.getDeltaTime() * 1000.0);
 
-        // Handle events
+        // Handle events and hand the settings to the simulation thread
         handleEvents();
+        postParameters();
 
-        // Fixed timestep updates
-        int steps = 0;
-        while (accumulator >= Config::FIXED_TIMESTEP && steps < Config::MAX_PHYSICS_STEPS) {
-            update(Config::FIXED_TIMESTEP);
-            accumulator -= Config::FIXED_TIMESTEP;
-            steps++;
-        }
+        // Physics runs on the simulation thread; take its newest state
+        snapshot = &simulation.acquireSnapshot();
+        time.setPhysicsStepIterations(snapshot->stepIterations);
+        renderAlpha = snapshot->getAlpha(SimulationSnapshot::Clock::now());
+        traceCounters();
 
         // Render
+        TraceScope renderScope("Render", "render");
         render();
     }
+
+    time.printReport(std::cout);
+}
+
+void Application::traceCounters() {
+    Tracer& tracer = Tracer::instance();
+    if (!tracer.isActive()) {
+        return;
+    }
+
+    tracer.counter("Balls", static_cast<double>(snapshot->getBallCount()));
+    tracer.counter("Candidate pairs", static_cast<double>(snapshot->pairCount));
+    tracer.counter("Pending respawns", static_cast<double>(snapshot->pendingRespawnCount));
 }
 
 void Application::cleanup() {
-    circleRenderer.cleanup();
+    simulation.stop();
+    circleBatch.cleanup();
+    containerRenderer.cleanup();
+    uiPanel.cleanup();
     textRenderer.cleanup();
     renderer.cleanup();
 }
 
 void Application::handleEvents() {
+    ProfileScope scope(ProfileZone::Events);
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
@@ -103,34 +168,15 @@ void Application::handleEvents() {
         } else if (event.type == SDL_KEYDOWN) {
             if (event.key.keysym.sym == SDLK_ESCAPE) {
                 running = false;
+            } else if (event.key.keysym.sym == SDLK_b) {
+                cycleBroadphase();
+            } else if (event.key.keysym.sym == SDLK_p) {
+                showProfiler = !showProfiler;
             }
-        } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-            bouncinessSlider.handleMouseDown(event.button.x, event.button.y);
-            ballSizeSlider.handleMouseDown(event.button.x, event.button.y);
-            holeSizeSlider.handleMouseDown(event.button.x, event.button.y);
-            respawnCountSlider.handleMouseDown(event.button.x, event.button.y);
-            gravitySlider.handleMouseDown(event.button.x, event.button.y);
-            diameterSlider.handleMouseDown(event.button.x, event.button.y);
-            resetButton.handleMouseDown(event.button.x, event.button.y);
-            pauseButton.handleMouseDown(event.button.x, event.button.y);
-        } else if (event.type == SDL_MOUSEBUTTONUP) {
-            bouncinessSlider.handleMouseUp();
-            ballSizeSlider.handleMouseUp();
-            holeSizeSlider.handleMouseUp();
-            respawnCountSlider.handleMouseUp();
-            gravitySlider.handleMouseUp();
-            diameterSlider.handleMouseUp();
-            resetButton.handleMouseUp(event.button.x, event.button.y);
-            pauseButton.handleMouseUp(event.button.x, event.button.y);
-        } else if (event.type == SDL_MOUSEMOTION) {
-            bouncinessSlider.handleMouseMove(event.motion.x, event.motion.y);
-            ballSizeSlider.handleMouseMove(event.motion.x, event.motion.y);
-            holeSizeSlider.handleMouseMove(event.motion.x, event.motion.y);
-            respawnCountSlider.handleMouseMove(event.motion.x, event.motion.y);
-            gravitySlider.handleMouseMove(event.motion.x, event.motion.y);
-            diameterSlider.handleMouseMove(event.motion.x, event.motion.y);
-            resetButton.handleMouseMove(event.motion.x, event.motion.y);
-            pauseButton.handleMouseMove(event.motion.x, event.motion.y);
+        } else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            // Target texture contents were lost
+            uiPanel.invalidate();
+        } else if (uiPanel.handleEvent(event)) {
             // Update values from sliders
             restitution = bouncinessSlider.getValue();
             ballRadius = ballSizeSlider.getValue();
@@ -142,98 +188,91 @@ void Application::handleEvents() {
     }
 }
 
-void Application::update(float deltaTime) {
-    // Skip update if paused
-    if (paused) {
-        return;
-    }
-
-    // Update configurable parameters
-    gameState.getBallManager().setBallRadius(ballRadius);
-    gameState.getContainer().setGapAngleDegrees(holeSize);
-    gameState.getContainer().setRadius(containerDiameter / 2.0f);
-    gameState.getPhysics().setGravity(gravity * 100.0f); // Convert m/s² to px/s²
-
-    // Update game state with respawn rate (BallManager handles queuing and safe spawning)
-    int respawnCount = static_cast<int>(respawnRate);
-    gameState.update(deltaTime, restitution, respawnCount);
+SimulationParameters Application::makeParameters() const {
+    SimulationParameters parameters;
+    parameters.restitution = restitution;
+    parameters.ballRadius = ballRadius;
+    parameters.gapAngleDegrees = holeSize;
+    parameters.respawnRate = respawnRate;
+    parameters.gravity = gravity * 100.0f;  // Convert m/s² to px/s²
+    parameters.containerRadius = containerDiameter / 2.0f;
+    parameters.physicsRate = physicsRate;
+    parameters.paused = paused;
+    parameters.resetRequests = resetRequests;
+    parameters.broadphaseCycleRequests = broadphaseCycleRequests;
+    return parameters;
+}
 
-    // Ensure at least one ball exists to keep simulation running
-    if (gameState.getBallCount() == 0 && gameState.getPendingRespawnCount() == 0) {
-        gameState.getBallManager().spawnInitialBall();
+void Application::postParameters() {
+    // Only post changes, so the simulation does not republish while idle
+    SimulationParameters parameters = makeParameters();
+    if (parameters != postedParameters) {
+        simulation.setParameters(parameters);
+        postedParameters = parameters;
     }
 }
 
 void Application::render() {
     // Clear screen
-    renderer.clear(Config::BACKGROUND_COLOR);
+    renderer.clear(toSDLColor(Config::BACKGROUND_COLOR));
 
     // Render game objects
     renderContainer();
     renderBalls();
     renderUI();
+    if (showProfiler) {
+        profilerOverlay.render(
+            renderer.getSDLRenderer(),
+            textRenderer,
+            Profiler::instance(),
+            Config::PROFILER_X,
+            Config::PROFILER_Y
+        );
+    }
 
     // Present
     renderer.endFrame();
 }
 
 void Application::renderContainer() {
-    const Container& container = gameState.getContainer();
-
-    Vector2D center = container.getCenter();
-    float radius = container.getRadius();
-    float gapStart = container.getGapStartAngle();
-    float gapEnd = container.getGapEndAngle();
+    // Cached ring texture, rotated to the interpolated rotation between the last two steps
+    float rewind = (1.0f - renderAlpha) * snapshot->rotationStep;
 
-    // Draw the container as an arc (excluding the gap)
-    // We need to draw from gapEnd to gapStart (the complement of the gap)
-    float arcStart = gapEnd;
-    float arcEnd = gapStart + MathUtils::TWO_PI;
-
-    circleRenderer.drawArc(
+    containerRenderer.render(
         renderer.getSDLRenderer(),
-        center,
-        radius,
-        arcStart,
-        arcEnd,
-        Config::CONTAINER_COLOR,
+        snapshot->containerCenter,
+        snapshot->containerRadius,
+        snapshot->gapEndAngle - snapshot->gapStartAngle,
+        snapshot->gapStartAngle - rewind,
+        snapshot->containerShapeVersion,
+        toSDLColor(Config::CONTAINER_COLOR),
         3  // thickness
     );
 }
 
 void Application::renderBalls() {
-    const std::vector<Ball>& balls = gameState.getBallManager().getBalls();
+    ProfileScope scope(ProfileZone::RenderBalls);
 
-    for (const Ball& ball : balls) {
-        circleRenderer.drawFilledCircleFast(
-            renderer.getSDLRenderer(),
-            ball.position,
-            ball.radius,
-            ball.color
-        );
+    const SimulationSnapshot& balls = *snapshot;
+    float alpha = renderAlpha;
+
+    // One textured quad per ball, submitted as a single draw call
+    circleBatch.begin();
+    for (size_t i = 0; i < balls.getBallCount(); ++i) {
+        // Blend from the position the last step started at
+        float x = balls.prevX[i] + (balls.x[i] - balls.prevX[i]) * alpha;
+        float y = balls.prevY[i] + (balls.y[i] - balls.prevY[i]) * alpha;
+
+        circleBatch.add(x, y, balls.radius[i], toSDLColor(balls.color[i]));
     }
+    circleBatch.flush(renderer.getSDLRenderer());
 }
 
 void Application::renderUI() {
-    // Render reset button
-    resetButton.render(renderer.getSDLRenderer());
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        "Reset",
-        Config::RESET_BUTTON_X + 25,
-        Config::RESET_BUTTON_Y + 7,
-        Config::TEXT_COLOR
-    );
+    ProfileScope scope(ProfileZone::RenderUI);
 
-    // Render pause button
-    pauseButton.render(renderer.getSDLRenderer());
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        paused ? "Resume" : "Pause",
-        Config::PAUSE_BUTTON_X + (paused ? 18 : 22),
-        Config::PAUSE_BUTTON_Y + 7,
-        Config::TEXT_COLOR
-    );
+    // Widgets and their labels (redrawn only when they change)
+    uiPanel.render(renderer.getSDLRenderer(), textRenderer);
 
     // Render FPS (cached)
     textRenderer.renderFPSCached(
@@ -246,7 +285,7 @@ void Application::renderUI() {
     // Render ball count (cached)
     textRenderer.renderBallCountCached(
         renderer.getSDLRenderer(),
-        gameState.getBallCount(),
+        snapshot->getBallCount(),
         Config::BALL_COUNT_X,
         Config::BALL_COUNT_Y
     );
@@ -259,110 +298,37 @@ void Application::renderUI() {
         Config::TIMER_DISPLAY_Y
     );
 
+    // Render frame-time percentiles (cached)
+    FrameTimeStats frameStats = time.getFrameTimeStats();
+    textRenderer.renderFrameTimeCached(
+        renderer.getSDLRenderer(),
+        frameStats.p50,
+        frameStats.p99,
+        Config::FRAME_TIME_X,
+        Config::FRAME_TIME_Y
+    );
+
     // Render pending respawn count (cached)
     textRenderer.renderPendingRespawnCached(
         renderer.getSDLRenderer(),
-        gameState.getPendingRespawnCount(),
+        snapshot->pendingRespawnCount,
         Config::PENDING_RESPAWN_X,
         Config::PENDING_RESPAWN_Y
     );
 
-    // Render bounciness slider
-    bouncinessSlider.render(renderer.getSDLRenderer(), "Bounciness");
-
-    // Render slider label and value
-    char bouncinessLabel[64];
-    snprintf(bouncinessLabel, sizeof(bouncinessLabel), "Bounciness: %.0f%%", restitution * 100.0f);
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        bouncinessLabel,
-        Config::SLIDER_X,
-        Config::SLIDER_Y - 25,
-        Config::TEXT_COLOR
-    );
-
-    // Render ball size slider
-    ballSizeSlider.render(renderer.getSDLRenderer(), "Ball Size");
-
-    // Render ball size label and value
-    char sizeLabel[64];
-    snprintf(sizeLabel, sizeof(sizeLabel), "Ball Size: %.0fpx", ballRadius * 2.0f);
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        sizeLabel,
-        Config::SIZE_SLIDER_X,
-        Config::SIZE_SLIDER_Y - 25,
-        Config::TEXT_COLOR
-    );
-
-    // Render hole size slider
-    holeSizeSlider.render(renderer.getSDLRenderer(), "Hole Size");
-
-    // Render hole size label and value
-    char holeLabel[64];
-    snprintf(holeLabel, sizeof(holeLabel), "Hole Size: %.0f deg", holeSize);
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        holeLabel,
-        Config::HOLE_SLIDER_X,
-        Config::HOLE_SLIDER_Y - 25,
-        Config::TEXT_COLOR
-    );
-
-    // Render respawn rate slider
-    respawnCountSlider.render(renderer.getSDLRenderer(), "Respawn Rate");
-
-    // Render respawn rate label and value
-    char respawnLabel[64];
-    if (respawnRate >= 1.0f) {
-        snprintf(respawnLabel, sizeof(respawnLabel), "Respawn: %dx", static_cast<int>(respawnRate));
-    } else {
-        // For rates < 1, show as "2:1" ratio format
-        float ratio = 1.0f / respawnRate;
-        snprintf(respawnLabel, sizeof(respawnLabel), "Respawn: %.0f:1 balls", ratio);
-    }
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        respawnLabel,
-        Config::RESPAWN_SLIDER_X,
-        Config::RESPAWN_SLIDER_Y - 25,
-        Config::TEXT_COLOR
-    );
-
-    // Render gravity slider
-    gravitySlider.render(renderer.getSDLRenderer(), "Gravity");
-
-    // Render gravity label and value
-    char gravityLabel[64];
-    snprintf(gravityLabel, sizeof(gravityLabel), "Gravity: %.1f m/s^2", gravity);
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        gravityLabel,
-        Config::GRAVITY_SLIDER_X,
-        Config::GRAVITY_SLIDER_Y - 25,
-        Config::TEXT_COLOR
-    );
-
-    // Render container diameter slider
-    diameterSlider.render(renderer.getSDLRenderer(), "Container Diameter");
-
-    // Render diameter label and value
-    char diameterLabel[64];
-    snprintf(diameterLabel, sizeof(diameterLabel), "Cont Diameter: %.0fpx", containerDiameter);
-    textRenderer.renderText(
-        renderer.getSDLRenderer(),
-        diameterLabel,
-        Config::DIAMETER_SLIDER_X,
-        Config::DIAMETER_SLIDER_Y - 25,
-        Config::TEXT_COLOR
-    );
+    // All of the above text in one draw call
+    textRenderer.flush(renderer.getSDLRenderer());
 }
 
 void Application::resetSimulation() {
-    // Clear all balls and reset to initial state
-    gameState.getBallManager().getBalls().clear();
-    gameState.initialize();
+    // Handled on the simulation thread (see SimulationThread::applyParameters)
+    ++resetRequests;
+
+    // Reset timer (frame-time statistics cover the whole session)
+    time.resetElapsedTime();
+}
 
-    // Reset timer
-    time = Time();
+void Application::cycleBroadphase() {
+    // The simulation thread switches backend and prints its name
+    ++broadphaseCycleRequests;
 }
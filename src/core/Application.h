@@ -1,11 +1,14 @@
 #pragma once
 
 #include "../rendering/Renderer.h"
-#include "../rendering/CircleRenderer.h"
+#include "../rendering/CircleBatch.h"
+#include "../rendering/ContainerRenderer.h"
 #include "../rendering/TextRenderer.h"
-#include "../game/GameState.h"
+#include "../rendering/ProfilerOverlay.h"
+#include "../game/SimulationThread.h"
 #include "../ui/Slider.h"
 #include "../ui/Button.h"
+#include "../ui/UiPanel.h"
 #include "Time.h"
 
 class Application {
@@ -17,13 +20,19 @@ public:
     void run();
     void cleanup();
 
+    // Physics steps per second (rendering interpolates between steps)
+    void setPhysicsRate(float hz) { physicsRate = hz; }
+
 private:
     // Core systems
     Renderer renderer;
-    GameState gameState;
+    SimulationThread simulation;
+    const SimulationSnapshot* snapshot;  // Latest simulation state (owned by simulation)
     Time time;
-    CircleRenderer circleRenderer;
+    CircleBatch circleBatch;
+    ContainerRenderer containerRenderer;
     TextRenderer textRenderer;
+    ProfilerOverlay profilerOverlay;
 
     // UI elements
     Slider bouncinessSlider;
@@ -34,22 +43,36 @@ private:
     Slider diameterSlider;
     Button resetButton;
     Button pauseButton;
+    UiPanel uiPanel;
     float restitution;
     float ballRadius;
     float holeSize;
     float respawnRate;
     float gravity;
     float containerDiameter;
+    float physicsRate;
 
     bool running;
     bool paused;
-    float accumulator;  // For fixed timestep
+    bool showProfiler;
+
+    // Commands for the simulation thread (counters, see SimulationParameters)
+    uint32_t resetRequests;
+    uint32_t broadphaseCycleRequests;
+    SimulationParameters postedParameters;
+    float renderAlpha;       // Blend between the snapshot's previous and current state
 
     // Game loop methods
     void handleEvents();
-    void update(float deltaTime);
     void render();
 
+    // Current slider values and commands for the simulation thread
+    SimulationParameters makeParameters() const;
+    void postParameters();
+
+    // Ball, pair and pending-respawn counter samples for the trace
+    void traceCounters();
+
     // Rendering helpers
     void renderContainer();
     void renderBalls();
@@ -57,4 +80,7 @@ private:
 
     // Reset functionality
     void resetSimulation();
+
+    // Switch to the next broadphase backend
+    void cycleBroadphase();
 };
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <SDL2/SDL.h>
+#include "../entities/Color.h"
 
 namespace Config {
     // Window settings
@@ -21,16 +21,22 @@ namespace Config {
     // Ball settings
     // constexpr float BALL_RADIUS = 12.5f;  // 25px diameter
     constexpr float BALL_RADIUS = 7.5f;  // 15px diameter
+    constexpr float MIN_BALL_RADIUS = 5.0f;   // Ball size slider range
+    constexpr float MAX_BALL_RADIUS = 25.0f;
     constexpr float BALL_MIN_VELOCITY = 50.0f;   // pixels/second
     constexpr float BALL_MAX_VELOCITY = 200.0f;  // pixels/second
 
     // Physics settings
     constexpr float GRAVITY = 9.8f * 100.0f;  // 980 px/s² (9.8 m/s² scaled for pixels)
-    constexpr float RESTITUTION = 1.0f;  // 100% bounce (perfectly elastic)
+    constexpr float RESTITUTION = 1.0f;  // 100% bounce above the solver's restitution threshold
 
     // Simulation settings
-    constexpr float FIXED_TIMESTEP = 1.0f / 120.0f;  // 120Hz physics updates
+    constexpr float PHYSICS_RATE = 120.0f;  // Default physics updates per second (--physics-rate)
+    constexpr float MIN_PHYSICS_RATE = 10.0f;  // Lowest accepted; longer steps let falling balls tunnel through the wall
+    constexpr float FIXED_TIMESTEP = 1.0f / PHYSICS_RATE;
     constexpr int MAX_PHYSICS_STEPS = 5;  // Prevent spiral of death
+    constexpr int PHYSICS_THREAD_COUNT = 0;  // Ball-ball resolution threads (0 = all hardware threads)
+    constexpr int SOLVER_ITERATIONS = 8;  // Contact solver velocity iterations per step
 
     // UI settings
     constexpr int FPS_DISPLAY_X = 10;
@@ -41,6 +47,8 @@ namespace Config {
     constexpr int PENDING_RESPAWN_Y = 180;
     constexpr int TIMER_DISPLAY_X = 10;
     constexpr int TIMER_DISPLAY_Y = 70;
+    constexpr int FRAME_TIME_X = 10;
+    constexpr int FRAME_TIME_Y = 210;
     constexpr int UI_FONT_SIZE = 20;
 
     // Slider settings (all shifted down by 50px)
@@ -90,8 +98,13 @@ namespace Config {
     constexpr int DIAMETER_SLIDER_WIDTH = 200;
     constexpr int DIAMETER_SLIDER_HEIGHT = 20;
 
+    // Profiler overlay settings (toggled with P)
+    constexpr int PROFILER_X = 10;
+    constexpr int PROFILER_Y = 360;
+    constexpr int PROFILER_WIDTH = 300;
+
     // Colors
-    const SDL_Color BACKGROUND_COLOR = {20, 20, 30, 255};
-    const SDL_Color CONTAINER_COLOR = {200, 200, 200, 255};
-    const SDL_Color TEXT_COLOR = {255, 255, 255, 255};
+    const Color BACKGROUND_COLOR = {20, 20, 30, 255};
+    const Color CONTAINER_COLOR = {200, 200, 200, 255};
+    const Color TEXT_COLOR = {255, 255, 255, 255};
 }
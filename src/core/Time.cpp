@@ -1,11 +1,13 @@
 #include "Time.h"
 #include <algorithm>
+#include <iomanip>
 
 Time::Time()
-    : lastTime(SDL_GetPerformanceCounter())
+    : lastTime(Clock::now())
     , currentTime(lastTime)
     , startTime(lastTime)
     , deltaTime(0.0f)
+    , rawDeltaTime(0.0f)
     , fps(0.0f)
     , frameCount(0)
     , elapsedTime(0.0f)
@@ -15,25 +17,68 @@ Time::Time()
     for (int i = 0; i < FPS_SAMPLE_COUNT; ++i) {
         fpsSamples[i] = 0.0f;
     }
+    physicsStepIterations.fill(0);
 }
 
 void Time::tick() {
     lastTime = currentTime;
-    currentTime = SDL_GetPerformanceCounter();
+    currentTime = Clock::now();
 
-    uint64_t frequency = SDL_GetPerformanceFrequency();
-    deltaTime = static_cast<float>(currentTime - lastTime) / static_cast<float>(frequency);
+    rawDeltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
+    frameTimes.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(currentTime - lastTime).count()));
 
-    // Clamp delta time to prevent huge jumps
-    deltaTime = std::min(deltaTime, 0.25f);
+    // Clamp delta time to prevent huge jumps (the histogram keeps the raw value)
+    deltaTime = std::min(rawDeltaTime, 0.25f);
 
     // Update elapsed time
-    elapsedTime = static_cast<float>(currentTime - startTime) / static_cast<float>(frequency);
+    elapsedTime = std::chrono::duration<float>(currentTime - startTime).count();
 
     frameCount++;
     updateFPS();
 }
 
+void Time::resetElapsedTime() {
+    startTime = currentTime;
+    elapsedTime = 0.0f;
+}
+
+FrameTimeStats Time::getFrameTimeStats() const {
+    FrameTimeStats stats;
+    stats.p50 = frameTimes.getPercentile(0.50) * 1e-3;
+    stats.p95 = frameTimes.getPercentile(0.95) * 1e-3;
+    stats.p99 = frameTimes.getPercentile(0.99) * 1e-3;
+    stats.max = frameTimes.getMax() * 1e-3;
+    stats.frames = frameTimes.getCount();
+    stats.spiralOfDeathIterations = physicsStepIterations[Config::MAX_PHYSICS_STEPS];
+    return stats;
+}
+
+void Time::printReport(std::ostream& out) const {
+    FrameTimeStats stats = getFrameTimeStats();
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "Frame times over " << stats.frames << " frames (ms): "
+        << std::fixed << std::setprecision(2)
+        << "p50 " << stats.p50
+        << "  p95 " << stats.p95
+        << "  p99 " << stats.p99
+        << "  max " << stats.max << std::endl;
+
+    out << "Physics steps per simulation iteration:";
+    for (int steps = 0; steps <= Config::MAX_PHYSICS_STEPS; ++steps) {
+        out << "  " << steps << ": " << physicsStepIterations[steps];
+    }
+    out << std::endl;
+
+    out << "Spiral-of-death iterations (" << Config::MAX_PHYSICS_STEPS << " steps): "
+        << stats.spiralOfDeathIterations << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
 void Time::updateFPS() {
     if (deltaTime > 0.0f) {
         float currentFPS = 1.0f / deltaTime;
@@ -1,7 +1,21 @@
 #pragma once
 
-#include <SDL2/SDL.h>
+#include "Config.h"
+#include "../profiling/LatencyHistogram.h"
+#include <array>
+#include <chrono>
 #include <cstdint>
+#include <ostream>
+
+// Tail frame-time statistics (milliseconds) since the last reset
+struct FrameTimeStats {
+    double p50;
+    double p95;
+    double p99;
+    double max;
+    uint64_t frames;
+    uint64_t spiralOfDeathIterations;  // Simulation iterations capped at MAX_PHYSICS_STEPS
+};
 
 class Time {
 public:
@@ -9,16 +23,36 @@ public:
 
     void tick();  // Call once per frame
 
-    float getDeltaTime() const { return deltaTime; }
+    // Simulation loop iterations by steps run, counted on the simulation
+    // thread (SimulationSnapshot::stepIterations); physics is not tied to frames
+    void setPhysicsStepIterations(const std::array<uint64_t, Config::MAX_PHYSICS_STEPS + 1>& iterations) {
+        physicsStepIterations = iterations;
+    }
+
+    // Restart the elapsed-time clock without losing the frame statistics
+    void resetElapsedTime();
+
+    float getDeltaTime() const { return deltaTime; }  // Clamped to 0.25s
+    float getRawDeltaTime() const { return rawDeltaTime; }
     float getFPS() const { return fps; }
     uint64_t getFrameCount() const { return frameCount; }
     float getElapsedTime() const { return elapsedTime; }  // Total elapsed time in seconds
 
+    // Percentiles of the raw (unclamped) frame times
+    FrameTimeStats getFrameTimeStats() const;
+    uint64_t getPhysicsStepIterations(int steps) const { return physicsStepIterations[steps]; }
+
+    // Frame-time percentiles and the physics steps per iteration distribution
+    void printReport(std::ostream& out) const;
+
 private:
-    uint64_t lastTime;
-    uint64_t currentTime;
-    uint64_t startTime;
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point lastTime;
+    Clock::time_point currentTime;
+    Clock::time_point startTime;
     float deltaTime;
+    float rawDeltaTime;
     float fps;
     uint64_t frameCount;
     float elapsedTime;
@@ -28,5 +62,9 @@ private:
     float fpsSamples[FPS_SAMPLE_COUNT];
     int fpsSampleIndex;
 
+    // Tail latency
+    LatencyHistogram frameTimes;  // Microseconds
+    std::array<uint64_t, Config::MAX_PHYSICS_STEPS + 1> physicsStepIterations;  // Iterations per step count
+
     void updateFPS();
 };
@@ -4,7 +4,7 @@
 uint32_t Ball::nextId = 0;
 
 Ball::Ball(const Vector2D& position, const Vector2D& velocity,
-           float radius, const SDL_Color& color)
+           float radius, const Color& color)
     : position(position)
     , velocity(velocity)
     , radius(radius)
@@ -15,6 +15,18 @@ Ball::Ball(const Vector2D& position, const Vector2D& velocity,
     calculateMass();
 }
 
+Ball::Ball(const Vector2D& position, const Vector2D& velocity,
+           float radius, const Color& color, uint32_t id)
+    : position(position)
+    , velocity(velocity)
+    , radius(radius)
+    , mass(0.0f)
+    , color(color)
+    , id(id)
+{
+    calculateMass();
+}
+
 void Ball::update(float deltaTime) {
     // Update position based on velocity
     position += velocity * deltaTime;
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "../math/Vector2D.h"
-#include <SDL2/SDL.h>
+#include "Color.h"
 #include <cstdint>
 
 class Ball {
 public:
     Ball(const Vector2D& position, const Vector2D& velocity,
-         float radius, const SDL_Color& color);
+         float radius, const Color& color);
+
+    // Rebuild a ball that already has an identifier (e.g. read back from a BallStore)
+    Ball(const Vector2D& position, const Vector2D& velocity,
+         float radius, const Color& color, uint32_t id);
 
     // Physics properties
     Vector2D position;
@@ -16,7 +20,7 @@ public:
     float mass;  // Derived from radius (mass = π * r²)
 
     // Visual properties
-    SDL_Color color;
+    Color color;
     uint32_t id;  // Unique identifier
 
     // Physics update
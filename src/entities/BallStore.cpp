@@ -0,0 +1,94 @@
+#include "BallStore.h"
+
+void BallStore::clear() {
+    truncate(0);
+}
+
+void BallStore::reserve(size_t capacity) {
+    x.reserve(capacity);
+    y.reserve(capacity);
+    vx.reserve(capacity);
+    vy.reserve(capacity);
+    radius.reserve(capacity);
+    invMass.reserve(capacity);
+    offScreen.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    restSteps.reserve(capacity);
+    asleep.reserve(capacity);
+    island.reserve(capacity);
+    color.reserve(capacity);
+    id.reserve(capacity);
+}
+
+void BallStore::push(const Ball& ball) {
+    x.push_back(ball.position.x);
+    y.push_back(ball.position.y);
+    vx.push_back(ball.velocity.x);
+    vy.push_back(ball.velocity.y);
+    radius.push_back(ball.radius);
+    invMass.push_back(1.0f / ball.mass);
+    offScreen.push_back(0);
+    prevX.push_back(ball.position.x);  // New balls do not interpolate in from elsewhere
+    prevY.push_back(ball.position.y);
+    restSteps.push_back(0);
+    asleep.push_back(0);
+    island.push_back(0);
+    color.push_back(ball.color);
+    id.push_back(ball.id);
+}
+
+Ball BallStore::getBall(size_t index) const {
+    return Ball(
+        Vector2D(x[index], y[index]),
+        Vector2D(vx[index], vy[index]),
+        radius[index],
+        color[index],
+        id[index]
+    );
+}
+
+void BallStore::setBall(size_t index, const Ball& ball) {
+    x[index] = ball.position.x;
+    y[index] = ball.position.y;
+    vx[index] = ball.velocity.x;
+    vy[index] = ball.velocity.y;
+    radius[index] = ball.radius;
+    invMass[index] = 1.0f / ball.mass;
+    color[index] = ball.color;
+    id[index] = ball.id;
+}
+
+void BallStore::moveBall(size_t from, size_t to) {
+    x[to] = x[from];
+    y[to] = y[from];
+    vx[to] = vx[from];
+    vy[to] = vy[from];
+    radius[to] = radius[from];
+    invMass[to] = invMass[from];
+    offScreen[to] = offScreen[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    restSteps[to] = restSteps[from];
+    asleep[to] = asleep[from];
+    island[to] = island[from];
+    color[to] = color[from];
+    id[to] = id[from];
+}
+
+void BallStore::truncate(size_t newSize) {
+    x.resize(newSize);
+    y.resize(newSize);
+    vx.resize(newSize);
+    vy.resize(newSize);
+    radius.resize(newSize);
+    invMass.resize(newSize);
+    offScreen.resize(newSize);
+    prevX.resize(newSize);
+    prevY.resize(newSize);
+    restSteps.resize(newSize);
+    asleep.resize(newSize);
+    island.resize(newSize);
+    color.resize(newSize);
+    id.resize(newSize);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Ball.h"
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays storage for all live balls.
+// Each property lives in its own contiguous column so the physics passes only
+// stream the fields they touch. Index i across every column describes one ball.
+class BallStore {
+public:
+    // Hot physics columns
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> radius;
+    std::vector<float> invMass;  // 1 / (π * r²)
+
+    // Written by the physics integration pass: 1 if the ball left the screen
+    std::vector<uint8_t> offScreen;
+
+    // Position at the start of the last step, for render interpolation
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+
+    // Sleep state (see SleepTracker)
+    std::vector<uint16_t> restSteps;  // Consecutive steps below the sleep speed
+    std::vector<uint8_t> asleep;
+    std::vector<uint32_t> island;     // Label of the sleeping island (0 = none)
+
+    // Cold columns (rendering / bookkeeping)
+    std::vector<Color> color;
+    std::vector<uint32_t> id;
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+
+    void clear();
+    void reserve(size_t capacity);
+
+    // Remember the current positions as the previous state (start of a step)
+    void storePreviousPositions() { prevX = x; prevY = y; }
+
+    // Append a ball (copies its fields into the columns)
+    void push(const Ball& ball);
+
+    // Thin value view of a single ball, for code that wants the old AoS shape
+    Ball getBall(size_t index) const;
+    void setBall(size_t index, const Ball& ball);
+
+    // Bounds checking (same rules as Ball::isOffScreen)
+    bool isOffScreen(size_t index, float screenWidth, float screenHeight) const {
+        return y[index] - radius[index] < 0.0f
+            || y[index] + radius[index] > screenHeight
+            || x[index] + radius[index] < 0.0f
+            || x[index] - radius[index] > screenWidth;
+    }
+
+    // Remove every ball for which pred(index) is true, keeping the survivors in order.
+    // Returns the number of removed balls.
+    template <typename Predicate>
+    size_t removeIf(Predicate pred) {
+        size_t count = size();
+        size_t write = 0;
+        for (size_t read = 0; read < count; ++read) {
+            if (pred(read)) {
+                continue;
+            }
+            if (write != read) {
+                moveBall(read, write);
+            }
+            ++write;
+        }
+        truncate(write);
+        return count - write;
+    }
+
+private:
+    void moveBall(size_t from, size_t to);
+    void truncate(size_t newSize);
+};
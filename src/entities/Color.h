@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// RGBA color for the simulation side. Same layout as SDL_Color, so the
+// entities and game code build without SDL (see toSDLColor in rendering/SdlColor.h)
+struct Color {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
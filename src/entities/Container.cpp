@@ -8,16 +8,52 @@ Container::Container(const Vector2D& center, float radius, float gapAngleDegrees
     , gapAngleDegrees(gapAngleDegrees)
     , rotationSpeed(360.0f / 10.0f)  // 360° / 10 seconds = 36°/s
     , currentAngleRad(0.0f)
+    , previousAngleRad(0.0f)
+    , shapeVersion(0)
 {
+    updateGapVectors();
 }
 
 void Container::update(float deltaTime) {
+    previousAngleRad = currentAngleRad;
+
     // Rotate at 36° per second (full rotation in 10 seconds)
     float deltaAngleDeg = rotationSpeed * deltaTime;
     currentAngleRad += MathUtils::degToRad(deltaAngleDeg);
 
     // Keep angle in [0, 2π] range
     currentAngleRad = MathUtils::normalizeAngle(currentAngleRad);
+
+    updateGapVectors();
+}
+
+void Container::setGapAngleDegrees(float degrees) {
+    if (degrees == gapAngleDegrees) {
+        return;
+    }
+    gapAngleDegrees = degrees;
+    ++shapeVersion;
+    updateGapVectors();
+}
+
+void Container::setRadius(float newRadius) {
+    if (newRadius == radius) {
+        return;
+    }
+    radius = newRadius;
+    ++shapeVersion;
+}
+
+void Container::updateGapVectors() {
+    float gapAngleRad = MathUtils::normalizeAngle(MathUtils::degToRad(gapAngleDegrees));
+    float endAngle = currentAngleRad + gapAngleRad;
+
+    gapStartDirection = Vector2D(std::cos(currentAngleRad), std::sin(currentAngleRad));
+    gapEndDirection = Vector2D(std::cos(endAngle), std::sin(endAngle));
+
+    // Same zero-width rule as MathUtils::isAngleInRange (0° and 360° have no gap)
+    hasGap = !MathUtils::floatEquals(gapAngleRad, 0.0f) && !MathUtils::floatEquals(gapAngleRad, MathUtils::TWO_PI);
+    wideGap = gapAngleRad > MathUtils::PI;
 }
 
 bool Container::isPointInsideContainer(const Vector2D& point) const {
@@ -26,16 +62,7 @@ bool Container::isPointInsideContainer(const Vector2D& point) const {
 }
 
 bool Container::isPointInGap(const Vector2D& point) const {
-    // Calculate angle of point relative to container center
-    float angle = std::atan2(point.y - center.y, point.x - center.x);
-    angle = MathUtils::normalizeAngle(angle);
-
-    // Get gap boundaries
-    float gapStart = getGapStartAngle();
-    float gapEnd = getGapEndAngle();
-
-    // Check if angle is within gap range
-    return MathUtils::isAngleInRange(angle, gapStart, gapEnd);
+    return isDirectionInGap(point.x - center.x, point.y - center.y);
 }
 
 float Container::getGapStartAngle() const {
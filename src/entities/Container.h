@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../math/Vector2D.h"
+#include <cstdint>
 
 class Container {
 public:
@@ -13,6 +14,15 @@ public:
     bool isPointInsideContainer(const Vector2D& point) const;
     bool isPointInGap(const Vector2D& point) const;
 
+    // Gap test for an offset (dx, dy) from the centre using the cached gap
+    // edge directions: two cross products instead of atan2 and fmod
+    bool isDirectionInGap(float dx, float dy) const {
+        bool afterStart = gapStartDirection.x * dy - gapStartDirection.y * dx >= 0.0f;
+        bool beforeEnd = gapEndDirection.x * dy - gapEndDirection.y * dx <= 0.0f;
+        bool inGap = wideGap ? (afterStart || beforeEnd) : (afterStart && beforeEnd);
+        return hasGap && inGap;
+    }
+
     // Get gap boundaries for collision detection (in radians)
     float getGapStartAngle() const;
     float getGapEndAngle() const;
@@ -21,11 +31,22 @@ public:
     Vector2D getCenter() const { return center; }
     float getRadius() const { return radius; }
     float getCurrentRotation() const { return currentAngleRad; }
+    float getPreviousRotation() const { return previousAngleRad; }  // Before the last update
     float getGapAngleDegrees() const { return gapAngleDegrees; }
 
+    // Cached gap edges (unit vectors), refreshed on every rotation step
+    Vector2D getGapStartDirection() const { return gapStartDirection; }
+    Vector2D getGapEndDirection() const { return gapEndDirection; }
+    bool hasGapOpening() const { return hasGap; }
+    bool isGapWide() const { return wideGap; }  // Gap wider than 180°
+
     // Configuration
-    void setGapAngleDegrees(float degrees) { gapAngleDegrees = degrees; }
-    void setRadius(float newRadius) { radius = newRadius; }
+    void setGapAngleDegrees(float degrees);
+    void setRadius(float newRadius);
+
+    // Changes whenever the radius or gap size changes (not on rotation), so
+    // cached renderings of the shape know when to rebuild
+    uint32_t getShapeVersion() const { return shapeVersion; }
 
 private:
     Vector2D center;
@@ -33,4 +54,14 @@ private:
     float gapAngleDegrees;     // Size of gap in degrees
     float rotationSpeed;        // Degrees per second
     float currentAngleRad;      // Current rotation angle in radians
+    float previousAngleRad;     // Rotation angle before the last update
+    uint32_t shapeVersion;
+
+    // Gap edge cache
+    Vector2D gapStartDirection;
+    Vector2D gapEndDirection;
+    bool hasGap;
+    bool wideGap;
+
+    void updateGapVectors();
 };
@@ -1,6 +1,7 @@
 #include "BallManager.h"
 #include "../core/Config.h"
 #include "../math/MathUtils.h"
+#include "../profiling/Profiler.h"
 #include <cstdlib>
 #include <ctime>
 
@@ -14,24 +15,16 @@ BallManager::BallManager(const Vector2D& spawnCenter, float ballRadius)
 }
 
 void BallManager::spawnInitialBall() {
-    Ball ball = createRandomBall(spawnCenter);
-    balls.push_back(ball);
+    balls.push(createRandomBall(spawnCenter));
 }
 
-void BallManager::update(float screenWidth, float screenHeight, int respawnCount) {
-    // Count how many balls are off-screen
-    size_t offScreenCount = 0;
-
-    // Remove balls that exited through any edge
-    auto it = balls.begin();
-    while (it != balls.end()) {
-        if (it->isOffScreen(screenWidth, screenHeight)) {
-            ++offScreenCount;
-            it = balls.erase(it);
-        } else {
-            ++it;
-        }
-    }
+void BallManager::update(int respawnCount) {
+    ProfileScope scope(ProfileZone::BallManager);
+
+    // Remove balls that exited through any edge (single compacting pass)
+    size_t offScreenCount = balls.removeIf([&](size_t i) {
+        return balls.offScreen[i] != 0;
+    });
 
     // Add to pending respawn queue
     if (offScreenCount > 0) {
@@ -41,15 +34,14 @@ void BallManager::update(float screenWidth, float screenHeight, int respawnCount
     // Try to spawn pending balls (only if spawn point is clear)
     if (pendingRespawnCount > 0 && !wouldCollideWithBalls(spawnCenter)) {
         // Spawn one ball at a time when space is available
-        Ball ball = createRandomBall(spawnCenter);
-        balls.push_back(ball);
+        balls.push(createRandomBall(spawnCenter));
         pendingRespawnCount--;
     }
 }
 
 Ball BallManager::createRandomBall(const Vector2D& position) {
     Vector2D velocity = getRandomVelocity();
-    SDL_Color color = getRandomColor();
+    Color color = getRandomColor();
     return Ball(position, velocity, ballRadius, color);
 }
 
@@ -64,13 +56,13 @@ Vector2D BallManager::getRandomVelocity() const {
     return Vector2D::fromAngle(angle, speed);
 }
 
-SDL_Color BallManager::getRandomColor() const {
+Color BallManager::getRandomColor() const {
     // Generate vibrant random colors
-    Uint8 r = static_cast<Uint8>(MathUtils::randomRangeInt(100, 255));
-    Uint8 g = static_cast<Uint8>(MathUtils::randomRangeInt(100, 255));
-    Uint8 b = static_cast<Uint8>(MathUtils::randomRangeInt(100, 255));
+    uint8_t r = static_cast<uint8_t>(MathUtils::randomRangeInt(100, 255));
+    uint8_t g = static_cast<uint8_t>(MathUtils::randomRangeInt(100, 255));
+    uint8_t b = static_cast<uint8_t>(MathUtils::randomRangeInt(100, 255));
 
-    return SDL_Color{r, g, b, 255};
+    return Color{r, g, b, 255};
 }
 
 void BallManager::removeOffScreenBalls(float screenHeight) {
@@ -82,13 +74,14 @@ void BallManager::removeOffScreenBalls(float screenHeight) {
 bool BallManager::wouldCollideWithBalls(const Vector2D& position) const {
     // Check if spawning a ball at this position would collide with any existing ball
     // Use a safety margin of 2x the combined radii to ensure adequate spacing
-    for (const auto& ball : balls) {
-        float distance = position.distance(ball.position);
-        float minDistance = ballRadius + ball.radius;
+    for (size_t i = 0; i < balls.size(); ++i) {
+        float dx = position.x - balls.x[i];
+        float dy = position.y - balls.y[i];
+        float minDistance = ballRadius + balls.radius[i];
         float safeDistance = minDistance * 2.0f;  // Require 2x spacing
 
         // If distance is less than safe distance, position is not clear
-        if (distance < safeDistance) {
+        if (dx * dx + dy * dy < safeDistance * safeDistance) {
             return true;
         }
     }
@@ -97,7 +90,6 @@ bool BallManager::wouldCollideWithBalls(const Vector2D& position) const {
 
 void BallManager::spawnReplacementBalls(size_t count) {
     for (size_t i = 0; i < count; ++i) {
-        Ball ball = createRandomBall(spawnCenter);
-        balls.push_back(ball);
+        balls.push(createRandomBall(spawnCenter));
     }
 }
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "../entities/Ball.h"
+#include "../entities/BallStore.h"
 #include "../math/Vector2D.h"
-#include <vector>
 
 class BallManager {
 public:
@@ -11,12 +11,12 @@ public:
     // Initialize with first ball
     void spawnInitialBall();
 
-    // Update: remove off-screen balls and spawn replacements
-    void update(float screenWidth, float screenHeight, int respawnCount = 2);
+    // Update: remove balls flagged off-screen by the physics step and spawn replacements
+    void update(int respawnCount = 2);
 
     // Access balls
-    std::vector<Ball>& getBalls() { return balls; }
-    const std::vector<Ball>& getBalls() const { return balls; }
+    BallStore& getBalls() { return balls; }
+    const BallStore& getBalls() const { return balls; }
 
     // Stats
     size_t getBallCount() const { return balls.size(); }
@@ -26,7 +26,7 @@ public:
     void setBallRadius(float radius) { ballRadius = radius; }
 
 private:
-    std::vector<Ball> balls;
+    BallStore balls;
     Vector2D spawnCenter;
     float ballRadius;
     size_t pendingRespawnCount;
@@ -34,7 +34,7 @@ private:
     // Spawning helpers
     Ball createRandomBall(const Vector2D& position);
     Vector2D getRandomVelocity() const;
-    SDL_Color getRandomColor() const;
+    Color getRandomColor() const;
 
     // Check if a position would collide with existing balls
     bool wouldCollideWithBalls(const Vector2D& position) const;
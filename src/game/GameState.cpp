@@ -1,5 +1,7 @@
 #include "GameState.h"
 #include "../core/Config.h"
+#include <algorithm>
+#include <thread>
 
 GameState::GameState()
     : ballManager(
@@ -13,6 +15,12 @@ GameState::GameState()
     )
     , physics(Config::GRAVITY)
 {
+    size_t threads = Config::PHYSICS_THREAD_COUNT > 0
+        ? static_cast<size_t>(Config::PHYSICS_THREAD_COUNT)
+        : static_cast<size_t>(std::thread::hardware_concurrency());
+    physics.setThreadCount(std::max<size_t>(threads, 1));
+    physics.setSolverIterations(Config::SOLVER_ITERATIONS);
+    physics.setScreenBounds(static_cast<float>(Config::WINDOW_WIDTH), static_cast<float>(Config::WINDOW_HEIGHT));
 }
 
 void GameState::initialize() {
@@ -21,6 +29,9 @@ void GameState::initialize() {
 }
 
 void GameState::update(float deltaTime, float restitution, int respawnCount) {
+    // Keep the state this step starts from, so rendering can blend towards the new one
+    ballManager.getBalls().storePreviousPositions();
+
     // Update container rotation
     container.update(deltaTime);
 
@@ -28,11 +39,7 @@ void GameState::update(float deltaTime, float restitution, int respawnCount) {
     physics.update(ballManager.getBalls(), container, deltaTime, restitution);
 
     // Update ball manager (remove off-screen balls, spawn replacements)
-    ballManager.update(
-        static_cast<float>(Config::WINDOW_WIDTH),
-        static_cast<float>(Config::WINDOW_HEIGHT),
-        respawnCount
-    );
+    ballManager.update(respawnCount);
 }
 
 size_t GameState::getBallCount() const {
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../core/Config.h"
+#include "../entities/Color.h"
+#include "../math/Vector2D.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Everything the renderer and HUD need from one simulation state, copied out
+// by the simulation thread so rendering never touches live physics data.
+// Holds both the last step's result and the state it started from, so the
+// renderer can draw any point in between (see getAlpha).
+struct SimulationSnapshot {
+    using Clock = std::chrono::steady_clock;
+
+    // Balls (same order and meaning as the BallStore columns)
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+    std::vector<float> radius;
+    std::vector<Color> color;
+
+    // Container
+    Vector2D containerCenter;
+    float containerRadius = 0.0f;
+    float gapStartAngle = 0.0f;  // Radians
+    float gapEndAngle = 0.0f;
+    float rotationStep = 0.0f;   // Rotation during the last step (radians)
+    uint32_t containerShapeVersion = 0;  // Container::getShapeVersion
+
+    // Timing
+    float timestep = Config::FIXED_TIMESTEP;
+    float accumulator = 0.0f;    // Unsimulated time left over when published
+    Clock::time_point publishTime;
+
+    // Stats
+    size_t pendingRespawnCount = 0;
+    size_t pairCount = 0;
+    size_t sleepingCount = 0;
+    uint64_t stepCount = 0;  // Fixed steps simulated since start
+
+    // Simulation loop iterations by the number of steps they ran; the last
+    // entry counts iterations capped at MAX_PHYSICS_STEPS (spiral of death)
+    std::array<uint64_t, Config::MAX_PHYSICS_STEPS + 1> stepIterations = {};
+
+    size_t getBallCount() const { return x.size(); }
+
+    // Blend factor between the previous state (0) and the current one (1)
+    // for a frame drawn at the given time
+    float getAlpha(Clock::time_point now) const {
+        float elapsed = std::chrono::duration<float>(now - publishTime).count();
+        return std::clamp((accumulator + elapsed) / timestep, 0.0f, 1.0f);
+    }
+};
+
+// Settings the UI hands to the simulation thread. Commands are counters, so
+// a command survives being overwritten by a later value before it is read
+struct SimulationParameters {
+    float restitution = Config::RESTITUTION;
+    float ballRadius = Config::BALL_RADIUS;
+    float gapAngleDegrees = Config::CONTAINER_GAP_PERCENT * 360.0f;
+    float respawnRate = 2.0f;
+    float gravity = Config::GRAVITY;  // Pixels per second²
+    float containerRadius = Config::CONTAINER_RADIUS;
+    float physicsRate = Config::PHYSICS_RATE;  // Steps per second
+    bool paused = false;
+
+    uint32_t resetRequests = 0;
+    uint32_t broadphaseCycleRequests = 0;
+};
+
+inline bool operator==(const SimulationParameters& a, const SimulationParameters& b) {
+    return a.restitution == b.restitution
+        && a.ballRadius == b.ballRadius
+        && a.gapAngleDegrees == b.gapAngleDegrees
+        && a.respawnRate == b.respawnRate
+        && a.gravity == b.gravity
+        && a.containerRadius == b.containerRadius
+        && a.physicsRate == b.physicsRate
+        && a.paused == b.paused
+        && a.resetRequests == b.resetRequests
+        && a.broadphaseCycleRequests == b.broadphaseCycleRequests;
+}
+
+inline bool operator!=(const SimulationParameters& a, const SimulationParameters& b) {
+    return !(a == b);
+}
@@ -0,0 +1,178 @@
+#include "SimulationThread.h"
+#include "../core/Config.h"
+#include "../math/MathUtils.h"
+#include "../profiling/Tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Longest stretch of real time one loop iteration tries to catch up on
+    constexpr float MAX_FRAME_TIME = 0.25f;
+}
+
+SimulationThread::SimulationThread()
+    : running(false)
+    , handledResetRequests(0)
+    , handledBroadphaseCycles(0)
+    , stepCount(0)
+    , stepIterations()
+{
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start(const SimulationParameters& initialParameters) {
+    if (running) {
+        return;
+    }
+
+    parameters = initialParameters;
+    handledResetRequests = parameters.resetRequests;
+    handledBroadphaseCycles = parameters.broadphaseCycleRequests;
+    parameterMailbox.getWriteBuffer() = parameters;
+    parameterMailbox.publish();
+
+    gameState.initialize();
+    publishSnapshot(1.0f / parameters.physicsRate, 0.0f);
+
+    running = true;
+    thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void SimulationThread::setParameters(const SimulationParameters& newParameters) {
+    parameterMailbox.getWriteBuffer() = newParameters;
+    parameterMailbox.publish();
+}
+
+const SimulationSnapshot& SimulationThread::acquireSnapshot() {
+    snapshots.acquire();
+    return snapshots.getReadBuffer();
+}
+
+void SimulationThread::run() {
+    Tracer::instance().setThreadName("Simulation");
+
+    float accumulator = 0.0f;
+    Clock::time_point lastTime = Clock::now();
+
+    while (running) {
+        bool changed = applyParameters();
+        float timestep = 1.0f / parameters.physicsRate;
+
+        Clock::time_point now = Clock::now();
+        float frameTime = std::chrono::duration<float>(now - lastTime).count();
+        lastTime = now;
+
+        // Paused time is not made up later
+        accumulator = parameters.paused ? 0.0f : accumulator + std::min(frameTime, MAX_FRAME_TIME);
+
+        int steps = 0;
+        while (accumulator >= timestep && steps < Config::MAX_PHYSICS_STEPS) {
+            step(timestep);
+            accumulator -= timestep;
+            steps++;
+        }
+        if (!parameters.paused) {
+            ++stepIterations[steps];
+        }
+
+        if (steps > 0 || changed) {
+            publishSnapshot(timestep, accumulator);
+        }
+
+        // Sleep until the next step is due
+        float wait = parameters.paused ? timestep : std::max(timestep - accumulator, 0.0f);
+        std::this_thread::sleep_for(std::chrono::duration<float>(wait));
+    }
+}
+
+bool SimulationThread::applyParameters() {
+    if (!parameterMailbox.acquire()) {
+        return false;
+    }
+    parameters = parameterMailbox.getReadBuffer();
+
+    if (parameters.resetRequests != handledResetRequests) {
+        handledResetRequests = parameters.resetRequests;
+        gameState.getBallManager().getBalls().clear();
+        gameState.initialize();
+    }
+
+    PhysicsEngine& physics = gameState.getPhysics();
+    while (handledBroadphaseCycles != parameters.broadphaseCycleRequests) {
+        ++handledBroadphaseCycles;
+        int next = (static_cast<int>(physics.getBroadphaseType()) + 1) % BROADPHASE_TYPE_COUNT;
+        physics.setBroadphase(static_cast<BroadphaseType>(next));
+        std::cout << "Broadphase: " << physics.getBroadphase().getName() << std::endl;
+    }
+
+    // Settings apply while running (a paused simulation does not change)
+    if (!parameters.paused) {
+        gameState.getBallManager().setBallRadius(parameters.ballRadius);
+        gameState.getContainer().setGapAngleDegrees(parameters.gapAngleDegrees);
+        gameState.getContainer().setRadius(parameters.containerRadius);
+        physics.setGravity(parameters.gravity);
+    }
+    return true;
+}
+
+void SimulationThread::step(float timestep) {
+    TraceScope stepScope("Update", "simulation");
+
+    // BallManager handles queuing and safe spawning
+    int respawnCount = static_cast<int>(parameters.respawnRate);
+    gameState.update(timestep, parameters.restitution, respawnCount);
+    ++stepCount;
+
+    // Ensure at least one ball exists to keep simulation running
+    if (gameState.getBallCount() == 0 && gameState.getPendingRespawnCount() == 0) {
+        gameState.getBallManager().spawnInitialBall();
+    }
+}
+
+void SimulationThread::publishSnapshot(float timestep, float accumulator) {
+    SimulationSnapshot& snapshot = snapshots.getWriteBuffer();
+    const BallStore& balls = gameState.getBallManager().getBalls();
+    const Container& container = gameState.getContainer();
+
+    snapshot.x.assign(balls.x.begin(), balls.x.end());
+    snapshot.y.assign(balls.y.begin(), balls.y.end());
+    snapshot.prevX.assign(balls.prevX.begin(), balls.prevX.end());
+    snapshot.prevY.assign(balls.prevY.begin(), balls.prevY.end());
+    snapshot.radius.assign(balls.radius.begin(), balls.radius.end());
+    snapshot.color.assign(balls.color.begin(), balls.color.end());
+
+    snapshot.containerCenter = container.getCenter();
+    snapshot.containerRadius = container.getRadius();
+    snapshot.gapStartAngle = container.getGapStartAngle();
+    snapshot.gapEndAngle = container.getGapEndAngle();
+    snapshot.containerShapeVersion = container.getShapeVersion();
+
+    // The angle wraps at 2π; rotation is always forwards
+    float rotationStep = container.getCurrentRotation() - container.getPreviousRotation();
+    snapshot.rotationStep = rotationStep < 0.0f ? rotationStep + MathUtils::TWO_PI : rotationStep;
+
+    snapshot.timestep = timestep;
+    snapshot.accumulator = accumulator;
+    snapshot.publishTime = Clock::now();
+
+    snapshot.pendingRespawnCount = gameState.getPendingRespawnCount();
+    snapshot.pairCount = gameState.getPhysics().getPairCount();
+    snapshot.sleepingCount = gameState.getPhysics().getSleepingCount();
+    snapshot.stepCount = stepCount;
+    snapshot.stepIterations = stepIterations;
+
+    snapshots.publish();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "GameState.h"
+#include "SimulationSnapshot.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <thread>
+
+// Runs GameState::update at the fixed timestep on its own thread, so a slow
+// present (vsync) does not stall physics and a slow step does not block
+// rendering. The UI posts settings through a lock-free mailbox; after each
+// batch of steps the thread publishes an immutable snapshot through a triple
+// buffer, of which the render thread only ever reads the latest.
+class SimulationThread {
+public:
+    SimulationThread();
+    ~SimulationThread();
+
+    // Spawn the first ball and start stepping with these settings
+    void start(const SimulationParameters& initialParameters);
+    void stop();
+
+    // UI thread: replace the settings (picked up before the next step)
+    void setParameters(const SimulationParameters& parameters);
+
+    // UI thread: newest published snapshot, valid until the next call
+    const SimulationSnapshot& acquireSnapshot();
+
+private:
+    GameState gameState;
+    std::thread thread;
+    std::atomic<bool> running;
+
+    TripleBuffer<SimulationParameters> parameterMailbox;
+    TripleBuffer<SimulationSnapshot> snapshots;
+
+    // Simulation thread state
+    SimulationParameters parameters;
+    uint32_t handledResetRequests;
+    uint32_t handledBroadphaseCycles;
+    uint64_t stepCount;
+    std::array<uint64_t, Config::MAX_PHYSICS_STEPS + 1> stepIterations;  // See SimulationSnapshot
+
+    void run();
+
+    // Take new settings from the mailbox; true if anything visible changed
+    bool applyParameters();
+    void step(float timestep);
+    void publishSnapshot(float timestep, float accumulator);
+};
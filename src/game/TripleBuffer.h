@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-writer, single-reader handoff of the latest value.
+// Three slots: the writer fills its slot and swaps it with the shared one,
+// the reader swaps its slot with the shared one when a newer value is there.
+// Neither side ever waits, the reader always sees a complete value, and
+// values the reader did not pick up in time are overwritten (latest wins).
+// The writer gets an old slot back, so it must overwrite every field;
+// containers inside keep their capacity, so steady-state publishing does not
+// allocate.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : writeIndex(0)
+        , shared(1)
+        , readIndex(2)
+    {
+    }
+
+    // Writer side
+    T& getWriteBuffer() { return slots[writeIndex]; }
+
+    void publish() {
+        uint8_t previous = shared.exchange(static_cast<uint8_t>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Reader side: pick up the newest published value; false if there was none
+    bool acquire() {
+        if (!(shared.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Valid until the next acquire()
+    const T& getReadBuffer() const { return slots[readIndex]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;  // Shared slot holds a value not yet read
+
+    std::array<T, 3> slots;
+    uint8_t writeIndex;
+    std::atomic<uint8_t> shared;
+    uint8_t readIndex;
+};
@@ -0,0 +1,178 @@
+// Headless simulation runner: steps GameState at the fixed timestep with no
+// window, then prints throughput. Links only marble_core, so it runs on
+// machines without SDL.
+//
+// Usage: marble_headless [--steps N] [--balls N] [--respawn N]
+//                        [--restitution E] [--threads N] [--seed S]
+//                        [--physics-rate HZ] [--trace FILE] [--help]
+
+#include "core/Config.h"
+#include "game/GameState.h"
+#include "math/MathUtils.h"
+#include "profiling/Tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    struct Options {
+        long steps = 12000;  // 100 simulated seconds at the default 120Hz
+        long balls = 0;      // Extra balls scattered in the container up front
+        int respawnCount = 2;
+        float restitution = Config::RESTITUTION;
+        int threads = 0;     // 0 = GameState default
+        unsigned int seed = 1;
+        float physicsRate = Config::PHYSICS_RATE;
+        const char* tracePath = nullptr;  // Chrome trace output (off if null)
+        bool help = false;
+    };
+
+    void printUsage(const char* program) {
+        std::fprintf(stderr,
+            "Usage: %s [--steps N] [--balls N] [--respawn N] [--restitution E] [--threads N] [--seed S] [--physics-rate HZ] [--trace FILE] [--help]\n",
+            program);
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* flag = argv[i];
+            if (std::strcmp(flag, "--help") == 0 || std::strcmp(flag, "-h") == 0) {
+                options.help = true;
+                return true;
+            }
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", flag);
+                return false;
+            }
+            const char* value = argv[++i];
+
+            if (std::strcmp(flag, "--steps") == 0) {
+                options.steps = std::atol(value);
+            } else if (std::strcmp(flag, "--balls") == 0) {
+                options.balls = std::atol(value);
+            } else if (std::strcmp(flag, "--respawn") == 0) {
+                options.respawnCount = std::atoi(value);
+            } else if (std::strcmp(flag, "--restitution") == 0) {
+                options.restitution = static_cast<float>(std::atof(value));
+            } else if (std::strcmp(flag, "--threads") == 0) {
+                options.threads = std::atoi(value);
+            } else if (std::strcmp(flag, "--seed") == 0) {
+                options.seed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+            } else if (std::strcmp(flag, "--physics-rate") == 0) {
+                options.physicsRate = static_cast<float>(std::atof(value));
+            } else if (std::strcmp(flag, "--trace") == 0) {
+                options.tracePath = value;
+            } else {
+                std::fprintf(stderr, "Unknown option %s\n", flag);
+                return false;
+            }
+        }
+        if (options.physicsRate < Config::MIN_PHYSICS_RATE) {
+            std::fprintf(stderr, "Physics rate must be at least %g Hz\n", Config::MIN_PHYSICS_RATE);
+            return false;
+        }
+        return options.steps > 0 && options.balls >= 0;
+    }
+
+    // Scatter balls uniformly over the container disc
+    void scatterBalls(GameState& gameState, long count) {
+        const Container& container = gameState.getContainer();
+        Vector2D center = container.getCenter();
+        float spread = std::max(container.getRadius() - Config::BALL_RADIUS, 0.0f);
+
+        BallStore& balls = gameState.getBallManager().getBalls();
+        balls.reserve(balls.size() + static_cast<size_t>(count));
+        for (long i = 0; i < count; ++i) {
+            float angle = MathUtils::randomRange(0.0f, MathUtils::TWO_PI);
+            float distance = spread * std::sqrt(MathUtils::randomRange(0.0f, 1.0f));
+            float heading = MathUtils::randomRange(0.0f, MathUtils::TWO_PI);
+            float speed = MathUtils::randomRange(Config::BALL_MIN_VELOCITY, Config::BALL_MAX_VELOCITY);
+
+            balls.push(Ball(
+                center + Vector2D::fromAngle(angle, distance),
+                Vector2D::fromAngle(heading, speed),
+                Config::BALL_RADIUS,
+                Color{255, 255, 255, 255}
+            ));
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.help) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    if (options.tracePath && !Tracer::instance().start(options.tracePath)) {
+        return 1;
+    }
+    Tracer& tracer = Tracer::instance();
+    tracer.setThreadName("Main");
+
+    GameState gameState;
+    if (options.threads > 0) {
+        gameState.getPhysics().setThreadCount(static_cast<size_t>(options.threads));
+    }
+
+    // BallManager seeds from the clock; reseed so runs are repeatable
+    std::srand(options.seed);
+    gameState.initialize();
+    scatterBalls(gameState, options.balls);
+
+    const float timestep = 1.0f / options.physicsRate;
+    std::printf("Headless run: %ld steps at %.0f Hz, %zu balls, %zu threads\n",
+        options.steps,
+        options.physicsRate,
+        gameState.getBallCount(),
+        gameState.getPhysics().getThreadCount());
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+
+    double ballSteps = 0.0;
+    size_t peakBalls = 0;
+    for (long step = 0; step < options.steps; ++step) {
+        {
+            TraceScope updateScope("Update", "app");
+            gameState.update(timestep, options.restitution, options.respawnCount);
+        }
+
+        // Same rule as Application: keep at least one ball alive
+        if (gameState.getBallCount() == 0 && gameState.getPendingRespawnCount() == 0) {
+            gameState.getBallManager().spawnInitialBall();
+        }
+
+        ballSteps += static_cast<double>(gameState.getBallCount());
+        peakBalls = std::max(peakBalls, gameState.getBallCount());
+
+        if (tracer.isActive()) {
+            tracer.counter("Balls", static_cast<double>(gameState.getBallCount()));
+            tracer.counter("Candidate pairs", static_cast<double>(gameState.getPhysics().getPairCount()));
+            tracer.counter("Pending respawns", static_cast<double>(gameState.getPendingRespawnCount()));
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    tracer.stop();
+    double simulated = static_cast<double>(options.steps) * timestep;
+
+    std::printf("Wall time:       %.3f s (%.1fx real time)\n", seconds, simulated / seconds);
+    std::printf("Steps/s:         %.1f\n", static_cast<double>(options.steps) / seconds);
+    std::printf("Ball-steps/s:    %.3e\n", ballSteps / seconds);
+    std::printf("Final balls:     %zu (peak %zu, %zu pending, %zu asleep)\n",
+        gameState.getBallCount(),
+        peakBalls,
+        gameState.getPendingRespawnCount(),
+        gameState.getPhysics().getSleepingCount());
+
+    return 0;
+}
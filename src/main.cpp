@@ -1,14 +1,41 @@
 #include "core/Application.h"
+#include "core/Config.h"
+#include "profiling/Tracer.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    // --trace FILE writes a Chrome trace of the session (open in Perfetto)
+    // --physics-rate HZ sets the fixed physics step rate (rendering interpolates)
+    const char* tracePath = nullptr;
+    float physicsRate = Config::PHYSICS_RATE;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--physics-rate") == 0 && i + 1 < argc) {
+            physicsRate = static_cast<float>(std::atof(argv[++i]));
+            if (physicsRate < Config::MIN_PHYSICS_RATE) {
+                std::cerr << "Physics rate must be at least " << Config::MIN_PHYSICS_RATE << " Hz" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--trace FILE] [--physics-rate HZ]" << std::endl;
+            return 1;
+        }
+    }
 
     Application app;
+    app.setPhysicsRate(physicsRate);
+
+    // Start tracing before initialize() spawns the simulation thread
+    if (tracePath && !Tracer::instance().start(tracePath)) {
+        return 1;
+    }
 
     if (!app.initialize()) {
         std::cerr << "Failed to initialize application" << std::endl;
+        Tracer::instance().stop();
         return 1;
     }
 
@@ -18,5 +45,7 @@ int main(int argc, char* argv[]) {
     app.run();
     app.cleanup();
 
+    Tracer::instance().stop();
+
     return 0;
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../entities/BallStore.h"
+#include "../entities/Container.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Bulk overlap filter for broadphase candidate pairs. Candidates outnumber
+// real contacts roughly 10:1, so pairs are tested several lanes at a time
+// (no sqrt, no division) and only overlapping ones are kept.
+class BatchNarrowphase {
+public:
+    using PairList = std::vector<std::pair<size_t, size_t>>;
+
+    // Appends every pair whose centres are closer than their combined radius
+    // plus margin to contacts, preserving candidate order
+    static void findContacts(
+        const BallStore& balls,
+        const std::pair<size_t, size_t>* pairs,
+        size_t count,
+        float margin,
+        PairList& contacts
+    );
+
+    static void findContacts(const BallStore& balls, const PairList& pairs, float margin, PairList& contacts) {
+        findContacts(balls, pairs.data(), pairs.size(), margin, contacts);
+    }
+
+    // Sets flags[i] to 1 for every ball touching the face of the container wall
+    // it started the step on (insideWall[i]), outside the gap; same rule as
+    // CollisionDetector::checkContainerCollision. Branch-free so it vectorizes.
+    static void flagWallContacts(
+        const BallStore& balls,
+        const Container& container,
+        const std::vector<uint8_t>& insideWall,
+        std::vector<uint8_t>& flags
+    );
+
+    // Kernel picked for this CPU ("avx2", "sse2" or "scalar")
+    static const char* getKernelName();
+};
@@ -1,14 +1,14 @@
 #include "CollisionDetector.h"
-#include "../math/MathUtils.h"
+#include <algorithm>
 #include <cmath>
 
-CollisionInfo CollisionDetector::checkBallCollision(const Ball& a, const Ball& b) {
+CollisionInfo CollisionDetector::checkBallCollision(const BallStore& balls, size_t a, size_t b) {
     CollisionInfo info;
 
     // Calculate distance between ball centers
-    Vector2D delta = b.position - a.position;
+    Vector2D delta(balls.x[b] - balls.x[a], balls.y[b] - balls.y[a]);
     float distanceSquared = delta.magnitudeSquared();
-    float combinedRadius = a.radius + b.radius;
+    float combinedRadius = balls.radius[a] + balls.radius[b];
     float combinedRadiusSquared = combinedRadius * combinedRadius;
 
     // Check if balls are overlapping
@@ -23,55 +23,105 @@ CollisionInfo CollisionDetector::checkBallCollision(const Ball& a, const Ball& b
 }
 
 CollisionInfo CollisionDetector::checkContainerCollision(
-    const Ball& ball,
-    const Container& container)
+    const BallStore& balls,
+    size_t index,
+    const Container& container,
+    bool startedInside)
 {
     CollisionInfo info;
+    float ballRadius = balls.radius[index];
+    float containerRadius = container.getRadius();
 
-    // Calculate distance from ball center to container center
-    Vector2D delta = ball.position - container.getCenter();
-    float distance = delta.magnitude();
+    // Offset from container center to ball center
+    Vector2D center = container.getCenter();
+    float dx = balls.x[index] - center.x;
+    float dy = balls.y[index] - center.y;
 
-    // Calculate the collision angle
-    float angle = std::atan2(delta.y, delta.x);
-    angle = MathUtils::normalizeAngle(angle);
-
-    // Get gap boundaries
-    float gapStart = container.getGapStartAngle();
-    float gapEnd = container.getGapEndAngle();
-    bool isInGap = MathUtils::isAngleInRange(angle, gapStart, gapEnd);
+    // Most balls are nowhere near the wall: reject on squared distance first
+    float distanceSquared = dx * dx + dy * dy;
+    float containerInnerRadius = std::max(containerRadius - ballRadius, 0.0f);
+    float containerOuterRadius = containerRadius + ballRadius;
+    bool touching = startedInside
+        ? distanceSquared > containerInnerRadius * containerInnerRadius
+        : distanceSquared < containerOuterRadius * containerOuterRadius;
+    if (!touching) {
+        return info;
+    }
 
     // Skip collision if in gap area
-    if (isInGap) {
+    if (container.isDirectionInGap(dx, dy)) {
         return info;
     }
 
-    // Determine which side of the container the ball is on
-    float containerInnerRadius = container.getRadius() - ball.radius;
-    float containerOuterRadius = container.getRadius() + ball.radius;
+    float distance = std::sqrt(distanceSquared);
+    Vector2D outward(dx / distance, dy / distance);
+    info.hasCollision = true;
 
-    // Check for collision with inner wall (ball pushing out from inside)
-    if (distance > containerInnerRadius && distance <= container.getRadius()) {
+    if (startedInside) {
         // Ball is penetrating inner wall from inside
-        info.hasCollision = true;
-        info.normal = delta.normalized();  // Normal points outward from center
-        info.penetration = distance - containerInnerRadius;
-    }
-    // Check for collision with outer wall (ball bouncing off from outside)
-    else if (distance > container.getRadius() && distance < containerOuterRadius) {
+        info.normal = outward;  // Normal points outward from center
+        info.penetration = distance - (containerRadius - ballRadius);
+    } else {
         // Ball is penetrating outer wall from outside
-        info.hasCollision = true;
-        info.normal = delta.normalized() * -1.0f;  // Normal points inward toward center
+        info.normal = outward * -1.0f;  // Normal points inward toward center
         info.penetration = containerOuterRadius - distance;
     }
 
     return info;
 }
 
-bool CollisionDetector::isAngleInGap(float angle, float gapStart, float gapEnd) {
-    return MathUtils::isAngleInRange(angle, gapStart, gapEnd);
-}
+SweepInfo CollisionDetector::sweepContainerCollision(
+    const Container& container,
+    const Vector2D& start,
+    const Vector2D& end,
+    float ballRadius)
+{
+    SweepInfo info;
+    float containerRadius = container.getRadius();
+    Vector2D startOffset = start - container.getCenter();
+    Vector2D motion = end - start;
+
+    // The center has to stop at R - r when coming from inside, R + r from outside
+    info.fromInside = startOffset.magnitudeSquared() < containerRadius * containerRadius;
+    float surface = info.fromInside
+        ? std::max(containerRadius - ballRadius, 0.0f)
+        : containerRadius + ballRadius;
+
+    // |startOffset + motion * t| = surface, solved for t in [0, 1]
+    float a = motion.magnitudeSquared();
+    float b = 2.0f * startOffset.dot(motion);
+    float c = startOffset.magnitudeSquared() - surface * surface;
 
-float CollisionDetector::getAngleFromCenter(const Vector2D& point, const Vector2D& center) {
-    return std::atan2(point.y - center.y, point.x - center.x);
+    float time = 0.0f;
+    bool touchingAtStart = info.fromInside ? c >= 0.0f : c <= 0.0f;
+    if (!touchingAtStart) {
+        float discriminant = b * b - 4.0f * a * c;
+        if (a <= 0.0f || discriminant < 0.0f) {
+            return info;
+        }
+
+        // Leaving the surface circle from inside, entering it from outside
+        float root = std::sqrt(discriminant);
+        time = info.fromInside ? (-b + root) / (2.0f * a) : (-b - root) / (2.0f * a);
+        if (time < 0.0f || time > 1.0f) {
+            return info;
+        }
+    }
+
+    // Balls pass freely through the gap
+    Vector2D contactOffset = startOffset + motion * time;
+    if (container.isDirectionInGap(contactOffset.x, contactOffset.y)) {
+        return info;
+    }
+
+    float distance = contactOffset.magnitude();
+    if (distance <= 0.0f) {
+        return info;
+    }
+
+    Vector2D outward = contactOffset / distance;
+    info.hasCollision = true;
+    info.time = time;
+    info.normal = info.fromInside ? outward : outward * -1.0f;
+    return info;
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../math/Vector2D.h"
-#include "../entities/Ball.h"
+#include "../entities/BallStore.h"
 #include "../entities/Container.h"
 
 struct CollisionInfo {
@@ -16,21 +16,43 @@ struct CollisionInfo {
     {}
 };
 
+// First contact of a ball moving along a straight path during one step
+struct SweepInfo {
+    bool hasCollision;
+    bool fromInside;        // Ball started the step inside the container
+    float time;             // Fraction of the step at first contact [0, 1]
+    Vector2D normal;        // Same convention as CollisionInfo
+
+    SweepInfo()
+        : hasCollision(false)
+        , fromInside(false)
+        , time(1.0f)
+        , normal(0.0f, 0.0f)
+    {}
+};
+
 class CollisionDetector {
 public:
     // Ball-Ball collision detection
-    static CollisionInfo checkBallCollision(const Ball& a, const Ball& b);
+    static CollisionInfo checkBallCollision(const BallStore& balls, size_t a, size_t b);
 
-    // Ball-Container collision detection (excluding gap)
+    // Ball-Container collision detection (excluding gap). The ball is held by
+    // the face of the wall it started the step on, so a ball that was pushed
+    // across the wall is pushed back instead of out the other side
     static CollisionInfo checkContainerCollision(
-        const Ball& ball,
-        const Container& container
+        const BallStore& balls,
+        size_t index,
+        const Container& container,
+        bool startedInside
     );
 
-private:
-    // Helper: Check if angle is within gap range
-    static bool isAngleInGap(float angle, float gapStart, float gapEnd);
-
-    // Helper: Get angle of point relative to container center
-    static float getAngleFromCenter(const Vector2D& point, const Vector2D& center);
+    // Swept ball-container test (continuous collision detection). Finds when a
+    // ball moving from start to end first touches the wall on the side it
+    // started on, so a fast ball cannot step over the wall in one tick
+    static SweepInfo sweepContainerCollision(
+        const Container& container,
+        const Vector2D& start,
+        const Vector2D& end,
+        float ballRadius
+    );
 };
@@ -1,17 +1,22 @@
 #pragma once
 
-#include "../entities/Ball.h"
+#include "../entities/BallStore.h"
 #include "CollisionDetector.h"
 
+// Responses outside the contact solver (resting and discrete contacts go
+// through ContactSolver)
 class CollisionResolver {
 public:
-    // Resolve elastic collision between two balls
-    static void resolveElasticCollision(Ball& a, Ball& b, const CollisionInfo& info, float restitution = 1.0f);
-
-    // Resolve ball-wall collision
-    static void resolveWallCollision(Ball& ball, const CollisionInfo& info, float restitution = 1.0f);
-
-private:
-    // Separate overlapping balls
-    static void separateBalls(Ball& a, Ball& b, float penetration, const Vector2D& normal);
+    // Resolve a swept wall hit: back up to the contact point, reflect the
+    // velocity with restitution, then spend the rest of the step on the
+    // rebound path
+    static void resolveSweptWallCollision(
+        BallStore& balls,
+        size_t index,
+        const Container& container,
+        const Vector2D& start,
+        const SweepInfo& sweep,
+        float deltaTime,
+        float restitution = 1.0f
+    );
 };
@@ -0,0 +1,121 @@
+#include "ContactCache.h"
+#include <algorithm>
+
+namespace {
+    constexpr uint64_t EMPTY_KEY = ~0ull;
+    constexpr size_t MIN_CAPACITY = 1024;
+
+    // Steps an unused entry keeps its impulse, so a contact that breaks for a
+    // step or two (a ball bouncing in place) still warm starts
+    constexpr uint32_t MAX_CONTACT_AGE = 3;
+
+    // Rebuilding the table to drop stale entries is a full pass, so it only
+    // runs every few steps; stale entries read as new in between
+    constexpr uint32_t EVICT_INTERVAL = 8;
+
+    size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity < value) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+}
+
+ContactCache::ContactCache()
+    : count(0)
+    , mask(0)
+    , step(0)
+{
+    slots.assign(MIN_CAPACITY, Entry{EMPTY_KEY, 0.0f, 0});
+    mask = MIN_CAPACITY - 1;
+}
+
+void ContactCache::beginStep() {
+    ++step;
+}
+
+void ContactCache::reserve(size_t additional) {
+    // Keep the load factor at or below 1/2
+    if ((count + additional) * 2 > slots.size()) {
+        rebuild(roundUpToPowerOfTwo((count + additional) * 2));
+    }
+}
+
+uint32_t ContactCache::acquire(uint32_t idA, uint32_t idB, bool& wasActive) {
+    if ((count + 1) * 2 > slots.size()) {
+        rebuild(slots.size() * 2);
+    }
+
+    uint64_t key = makeKey(idA, idB);
+    size_t slot = home(key);
+    while (slots[slot].key != key && slots[slot].key != EMPTY_KEY) {
+        slot = (slot + 1) & mask;
+    }
+
+    Entry& entry = slots[slot];
+    wasActive = entry.key == key && entry.step + 1 == step;
+    if (entry.key == EMPTY_KEY) {
+        entry.key = key;
+        entry.impulse = 0.0f;
+        ++count;
+    } else if (isStale(entry)) {
+        entry.impulse = 0.0f;
+    }
+    entry.step = step;
+
+    return static_cast<uint32_t>(slot);
+}
+
+void ContactCache::endStep() {
+    if (step % EVICT_INTERVAL != 0) {
+        return;
+    }
+
+    // Shrink once the table is mostly empty, otherwise rebuild in place
+    size_t capacity = slots.size();
+    if (count * 8 < capacity && capacity > MIN_CAPACITY) {
+        capacity /= 2;
+    }
+    rebuild(capacity);
+}
+
+void ContactCache::clear() {
+    std::fill(slots.begin(), slots.end(), Entry{EMPTY_KEY, 0.0f, 0});
+    count = 0;
+}
+
+uint64_t ContactCache::makeKey(uint32_t idA, uint32_t idB) {
+    uint32_t low = std::min(idA, idB);
+    uint32_t high = std::max(idA, idB);
+    return (static_cast<uint64_t>(low) << 32) | high;
+}
+
+size_t ContactCache::home(uint64_t key) const {
+    // Fibonacci hashing: ids are sequential, so spread them with a multiply
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+bool ContactCache::isStale(const Entry& entry) const {
+    return step - entry.step > MAX_CONTACT_AGE;
+}
+
+void ContactCache::rebuild(size_t capacity) {
+    scratch.swap(slots);
+    slots.assign(capacity, Entry{EMPTY_KEY, 0.0f, 0});
+    mask = capacity - 1;
+    count = 0;
+
+    for (const Entry& entry : scratch) {
+        if (entry.key == EMPTY_KEY || isStale(entry)) {
+            continue;
+        }
+
+        size_t slot = home(entry.key);
+        while (slots[slot].key != EMPTY_KEY) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = entry;
+        ++count;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Persistent ball-ball contacts, keyed by the (Ball::id, Ball::id) pair so
+// entries survive the index shuffling of BallStore::removeIf. Each entry
+// carries the accumulated normal impulse of the last step it was used in,
+// which the solver applies up front (warm starting) instead of rebuilding the
+// impulse from zero every step.
+//
+// Open addressing with linear probing over a power-of-two table. Entries are
+// stamped with the step they were last used in; one not used for
+// MAX_CONTACT_AGE steps reads as new, and stale entries are dropped when the
+// table is rebuilt (every few steps, or when it grows).
+class ContactCache {
+public:
+    ContactCache();
+
+    // Start a new step (advances the age stamp)
+    void beginStep();
+
+    // Make room for this many acquire() calls without a rehash, so slots
+    // returned during the step stay valid until endStep()
+    void reserve(size_t additional);
+
+    // Slot of the entry for this pair, inserted with zero impulse if missing
+    // or stale. Order of the ids does not matter. wasActive is set if the
+    // pair was also acquired in the previous step.
+    uint32_t acquire(uint32_t idA, uint32_t idB, bool& wasActive);
+
+    float getImpulse(uint32_t slot) const { return slots[slot].impulse; }
+    void setImpulse(uint32_t slot, float impulse) { slots[slot].impulse = impulse; }
+
+    // Finish the step; periodically evicts entries that aged out
+    void endStep();
+
+    void clear();
+
+    // Stats
+    size_t size() const { return count; }
+    size_t getCapacity() const { return slots.size(); }
+
+private:
+    struct Entry {
+        uint64_t key;
+        float impulse;
+        uint32_t step;
+    };
+
+    std::vector<Entry> slots;
+    std::vector<Entry> scratch;  // Reused by rebuild()
+    size_t count;
+    size_t mask;
+    uint32_t step;
+
+    static uint64_t makeKey(uint32_t idA, uint32_t idB);
+    size_t home(uint64_t key) const;
+    bool isStale(const Entry& entry) const;
+
+    // Reinsert the live entries into a table of the given capacity
+    void rebuild(size_t capacity);
+};
@@ -0,0 +1,246 @@
+#include "ContactSolver.h"
+#include "CollisionDetector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int DEFAULT_ITERATIONS = 8;
+
+    // Impacts slower than this (pixels/second) do not bounce. Without it a
+    // resting ball, which gains g * dt every step, is bounced back up by
+    // restitution and a pile never settles
+    constexpr float RESTITUTION_THRESHOLD = 30.0f;
+
+    // Overlap (pixels) left in place, so a resting contact is still found
+    // next step and picks up its cached impulse
+    constexpr float LINEAR_SLOP = 0.1f;
+
+    // Fraction of the remaining overlap removed per step; removing all of it
+    // at once makes neighbours in a pile push each other around
+    constexpr float POSITION_CORRECTION = 0.8f;
+
+    inline float getBounceSpeed(float normalVelocity, float restitution) {
+        return normalVelocity < -RESTITUTION_THRESHOLD ? -restitution * normalVelocity : 0.0f;
+    }
+
+    inline void applyImpulse(BallStore& balls, const ContactConstraint& c, float impulse) {
+        float px = c.normalX * impulse;
+        float py = c.normalY * impulse;
+        float invA = balls.invMass[c.a];
+        float invB = balls.invMass[c.b];
+
+        balls.vx[c.a] -= px * invA;
+        balls.vy[c.a] -= py * invA;
+        balls.vx[c.b] += px * invB;
+        balls.vy[c.b] += py * invB;
+    }
+
+    inline void applyWallImpulse(BallStore& balls, const ContactConstraint& c, float impulse) {
+        float invA = balls.invMass[c.a];
+        balls.vx[c.a] -= c.normalX * impulse * invA;
+        balls.vy[c.a] -= c.normalY * impulse * invA;
+    }
+
+    // Accumulated impulse clamping: a later iteration may take back part of
+    // an earlier push, but never pull. Returns the increment to apply
+    inline float accumulate(ContactConstraint& c, float normalVelocity, float targetVelocity) {
+        float lambda = c.normalMass * (targetVelocity - normalVelocity);
+        float accumulated = std::max(c.impulse + lambda, 0.0f);
+        lambda = accumulated - c.impulse;
+        c.impulse = accumulated;
+        return lambda;
+    }
+}
+
+ContactSolver::ContactSolver()
+    : iterations(DEFAULT_ITERATIONS)
+{
+}
+
+void ContactSolver::setIterations(int iterations) {
+    this->iterations = std::max(iterations, 1);
+}
+
+bool ContactSolver::makeConstraint(const BallStore& balls, size_t a, size_t b, float restitution, ContactConstraint& constraint) {
+    CollisionInfo info = CollisionDetector::checkBallCollision(balls, a, b);
+    if (!info.hasCollision) {
+        return false;
+    }
+
+    float invTotal = balls.invMass[a] + balls.invMass[b];
+    float approachX = balls.vx[b] - balls.vx[a];
+    float approachY = balls.vy[b] - balls.vy[a];
+    float normalVelocity = approachX * info.normal.x + approachY * info.normal.y;
+
+    constraint.a = static_cast<uint32_t>(a);
+    constraint.b = static_cast<uint32_t>(b);
+    constraint.normalX = info.normal.x;
+    constraint.normalY = info.normal.y;
+    constraint.normalMass = invTotal > 0.0f ? 1.0f / invTotal : 0.0f;
+    constraint.bounceSpeed = getBounceSpeed(normalVelocity, restitution);
+    constraint.impulse = 0.0f;
+    constraint.cacheSlot = 0;
+    return true;
+}
+
+bool ContactSolver::makeWallConstraint(
+    const BallStore& balls,
+    size_t index,
+    const Container& container,
+    bool startedInside,
+    float restitution,
+    ContactConstraint& constraint)
+{
+    CollisionInfo info = CollisionDetector::checkContainerCollision(balls, index, container, startedInside);
+    if (!info.hasCollision) {
+        return false;
+    }
+
+    // The wall does not move, so the approach speed is the ball's own
+    float normalVelocity = -(balls.vx[index] * info.normal.x + balls.vy[index] * info.normal.y);
+
+    constraint.a = static_cast<uint32_t>(index);
+    constraint.b = WALL_ID;
+    constraint.normalX = info.normal.x;
+    constraint.normalY = info.normal.y;
+    constraint.normalMass = 1.0f / balls.invMass[index];
+    constraint.bounceSpeed = getBounceSpeed(normalVelocity, restitution);
+    constraint.impulse = 0.0f;
+    constraint.cacheSlot = 0;
+    return true;
+}
+
+void ContactSolver::beginStep() {
+    constraints.clear();
+    wallConstraints.clear();
+    cache.beginStep();
+}
+
+void ContactSolver::warmStart(BallStore& balls) {
+    // No rehash while slots are held
+    cache.reserve(constraints.size() + wallConstraints.size());
+
+    bool wasActive = false;
+    for (ContactConstraint& c : constraints) {
+        c.cacheSlot = cache.acquire(balls.id[c.a], balls.id[c.b], wasActive);
+        c.bounceSpeed = wasActive ? 0.0f : c.bounceSpeed;
+        c.impulse = cache.getImpulse(c.cacheSlot);
+        if (c.impulse != 0.0f) {
+            applyImpulse(balls, c, c.impulse);
+        }
+    }
+
+    for (ContactConstraint& c : wallConstraints) {
+        c.cacheSlot = cache.acquire(balls.id[c.a], WALL_ID, wasActive);
+        c.bounceSpeed = wasActive ? 0.0f : c.bounceSpeed;
+        c.impulse = cache.getImpulse(c.cacheSlot);
+        if (c.impulse != 0.0f) {
+            applyWallImpulse(balls, c, c.impulse);
+        }
+    }
+}
+
+void ContactSolver::solveVelocities(BallStore& balls, ContactConstraint* begin, ContactConstraint* end) {
+    for (ContactConstraint* c = begin; c != end; ++c) {
+        float normalVelocity = (balls.vx[c->b] - balls.vx[c->a]) * c->normalX
+                             + (balls.vy[c->b] - balls.vy[c->a]) * c->normalY;
+        applyImpulse(balls, *c, accumulate(*c, normalVelocity, 0.0f));
+    }
+}
+
+void ContactSolver::solveWallVelocities(BallStore& balls, ContactConstraint* begin, ContactConstraint* end) {
+    for (ContactConstraint* c = begin; c != end; ++c) {
+        float normalVelocity = -(balls.vx[c->a] * c->normalX + balls.vy[c->a] * c->normalY);
+        applyWallImpulse(balls, *c, accumulate(*c, normalVelocity, 0.0f));
+    }
+}
+
+void ContactSolver::applyRestitution(BallStore& balls, ContactConstraint* begin, ContactConstraint* end) {
+    for (ContactConstraint* c = begin; c != end; ++c) {
+        if (c->bounceSpeed == 0.0f || c->impulse == 0.0f) {
+            continue;
+        }
+        float normalVelocity = (balls.vx[c->b] - balls.vx[c->a]) * c->normalX
+                             + (balls.vy[c->b] - balls.vy[c->a]) * c->normalY;
+        applyImpulse(balls, *c, accumulate(*c, normalVelocity, c->bounceSpeed));
+    }
+}
+
+void ContactSolver::applyWallRestitution(BallStore& balls, ContactConstraint* begin, ContactConstraint* end) {
+    for (ContactConstraint* c = begin; c != end; ++c) {
+        if (c->bounceSpeed == 0.0f || c->impulse == 0.0f) {
+            continue;
+        }
+        float normalVelocity = -(balls.vx[c->a] * c->normalX + balls.vy[c->a] * c->normalY);
+        applyWallImpulse(balls, *c, accumulate(*c, normalVelocity, c->bounceSpeed));
+    }
+}
+
+void ContactSolver::correctPositions(BallStore& balls, const ContactConstraint* begin, const ContactConstraint* end) {
+    for (const ContactConstraint* c = begin; c != end; ++c) {
+        // Overlap from the current positions: earlier corrections in the
+        // range may already have moved these balls
+        float dx = balls.x[c->b] - balls.x[c->a];
+        float dy = balls.y[c->b] - balls.y[c->a];
+        float combinedRadius = balls.radius[c->a] + balls.radius[c->b];
+        float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared >= combinedRadius * combinedRadius) {
+            continue;
+        }
+
+        float distance = std::sqrt(distanceSquared);
+        float nx = c->normalX;
+        float ny = c->normalY;
+        if (distance > 0.0001f) {
+            nx = dx / distance;
+            ny = dy / distance;
+        }
+
+        float correction = POSITION_CORRECTION * std::max(combinedRadius - distance - LINEAR_SLOP, 0.0f);
+        float invA = balls.invMass[c->a];
+        float invB = balls.invMass[c->b];
+        float share = correction / (invA + invB);
+
+        // Lighter ball moves further
+        balls.x[c->a] -= nx * share * invA;
+        balls.y[c->a] -= ny * share * invA;
+        balls.x[c->b] += nx * share * invB;
+        balls.y[c->b] += ny * share * invB;
+    }
+}
+
+void ContactSolver::correctWallPosition(BallStore& balls, const Container& container, size_t index, bool startedInside) {
+    Vector2D center = container.getCenter();
+    float containerRadius = container.getRadius();
+    float radius = balls.radius[index];
+
+    float dx = balls.x[index] - center.x;
+    float dy = balls.y[index] - center.y;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance <= 0.0f) {
+        return;
+    }
+
+    // Outward offset to the face holding the ball (negative moves it inwards).
+    // The wall cannot give way, so it takes the whole correction
+    float surface = startedInside ? std::max(containerRadius - radius, 0.0f) : containerRadius + radius;
+    float penetration = startedInside ? distance - surface : surface - distance;
+    float correction = std::max(penetration - LINEAR_SLOP, 0.0f);
+    if (correction <= 0.0f) {
+        return;
+    }
+
+    float target = startedInside ? distance - correction : distance + correction;
+    balls.x[index] = center.x + dx * (target / distance);
+    balls.y[index] = center.y + dy * (target / distance);
+}
+
+void ContactSolver::endStep() {
+    for (const ContactConstraint& c : constraints) {
+        cache.setImpulse(c.cacheSlot, c.impulse);
+    }
+    for (const ContactConstraint& c : wallConstraints) {
+        cache.setImpulse(c.cacheSlot, c.impulse);
+    }
+    cache.endStep();
+}
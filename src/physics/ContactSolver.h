@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../entities/BallStore.h"
+#include "../entities/Container.h"
+#include "ContactCache.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One contact prepared for the solver. The normal points from a to b; for a
+// wall contact b is ContactSolver::WALL_ID and the normal points into the wall.
+struct ContactConstraint {
+    uint32_t a;
+    uint32_t b;
+    float normalX;
+    float normalY;
+    float normalMass;     // 1 / (invMass[a] + invMass[b])
+    float bounceSpeed;    // Separating speed restitution asks for (new contacts only)
+    float impulse;        // Accumulated normal impulse (>= 0)
+    uint32_t cacheSlot;
+};
+
+// Sequential-impulse solver for ball-ball and ball-wall contacts with warm
+// starting. Every step the contacts are rebuilt, then seeded with the impulse
+// their pair ended the previous step with (ContactCache). Each iteration then
+// corrects every contact's accumulated impulse towards zero approach speed,
+// clamped so contacts only push. A resting pile converges in a handful of
+// iterations because most of the answer carries over from the previous step.
+// Wall contacts are solved in the same iterations (the wall is immovable), so
+// the weight of a pile reaches the wall instead of being bounced back into it.
+//
+// Restitution is a separate pass after the iterations, and only for contacts
+// that are new this step: bouncing persistent contacts, or mixing bounce
+// targets into the iterations, pumps energy into a packed pile.
+//
+// Overlap is removed afterwards by moving positions only (no velocity change),
+// leaving a small slop so resting contacts persist from step to step.
+//
+// The range functions touch only the balls of the constraints they are given,
+// so ranges with disjoint balls can be solved concurrently.
+class ContactSolver {
+public:
+    // Stands in for the second ball of a wall contact (cache key and b)
+    static constexpr uint32_t WALL_ID = 0xFFFFFFFFu;
+
+    ContactSolver();
+
+    void setIterations(int iterations);
+    int getIterations() const { return iterations; }
+
+    // Fill constraint for an overlapping pair; false if a and b do not overlap
+    static bool makeConstraint(const BallStore& balls, size_t a, size_t b, float restitution, ContactConstraint& constraint);
+
+    // Fill constraint for a ball touching the wall face it started the step
+    // on (see CollisionDetector::checkContainerCollision); false if it does not
+    static bool makeWallConstraint(
+        const BallStore& balls,
+        size_t index,
+        const Container& container,
+        bool startedInside,
+        float restitution,
+        ContactConstraint& constraint
+    );
+
+    // Start a step: drops last step's constraints
+    void beginStep();
+    std::vector<ContactConstraint>& getConstraints() { return constraints; }
+    std::vector<ContactConstraint>& getWallConstraints() { return wallConstraints; }
+
+    // Look up every constraint's cached impulse and apply it (serial)
+    void warmStart(BallStore& balls);
+
+    // One velocity iteration over a range of constraints
+    static void solveVelocities(BallStore& balls, ContactConstraint* begin, ContactConstraint* end);
+    static void solveWallVelocities(BallStore& balls, ContactConstraint* begin, ContactConstraint* end);
+
+    // Bounce pass after the velocity iterations: contacts that pushed and
+    // were hit fast enough leave at restitution times their approach speed
+    static void applyRestitution(BallStore& balls, ContactConstraint* begin, ContactConstraint* end);
+    static void applyWallRestitution(BallStore& balls, ContactConstraint* begin, ContactConstraint* end);
+
+    // Push overlapping balls apart over a range of constraints
+    static void correctPositions(BallStore& balls, const ContactConstraint* begin, const ContactConstraint* end);
+
+    // Move a ball back onto the wall face it started the step on. Run on
+    // fresh wall contacts after correctPositions, which can push balls that
+    // had no wall constraint into (or through) the wall
+    static void correctWallPosition(BallStore& balls, const Container& container, size_t index, bool startedInside);
+
+    // Save the accumulated impulses for the next step's warm start
+    void endStep();
+
+    // Stats
+    size_t getContactCount() const { return constraints.size() + wallConstraints.size(); }
+    size_t getCachedContactCount() const { return cache.size(); }
+
+private:
+    int iterations;
+    std::vector<ContactConstraint> constraints;
+    std::vector<ContactConstraint> wallConstraints;
+    ContactCache cache;
+};
@@ -0,0 +1,424 @@
+#include "DynamicAabbTree.h"
+#include <algorithm>
+
+namespace {
+    // Fattening applied to every leaf box
+    constexpr float AABB_MARGIN = 2.0f;               // pixels
+    constexpr float AABB_RADIUS_MARGIN = 0.25f;       // fraction of the ball radius
+    constexpr float AABB_VELOCITY_LOOKAHEAD = 1.0f / 30.0f;  // seconds of predicted motion
+}
+
+DynamicAabbTree::Aabb DynamicAabbTree::Aabb::combine(const Aabb& a, const Aabb& b) {
+    return Aabb{
+        std::min(a.minX, b.minX),
+        std::min(a.minY, b.minY),
+        std::max(a.maxX, b.maxX),
+        std::max(a.maxY, b.maxY)
+    };
+}
+
+DynamicAabbTree::DynamicAabbTree()
+    : root(NULL_NODE)
+    , freeList(NULL_NODE)
+    , step(0)
+    , reinsertCount(0)
+{
+}
+
+DynamicAabbTree::Aabb DynamicAabbTree::tightBox(const BallStore& balls, size_t index) {
+    float r = balls.radius[index];
+    return Aabb{balls.x[index] - r, balls.y[index] - r, balls.x[index] + r, balls.y[index] + r};
+}
+
+DynamicAabbTree::Aabb DynamicAabbTree::fatBox(const BallStore& balls, size_t index) {
+    Aabb box = tightBox(balls, index);
+    float margin = AABB_MARGIN + AABB_RADIUS_MARGIN * balls.radius[index];
+    box.minX -= margin;
+    box.minY -= margin;
+    box.maxX += margin;
+    box.maxY += margin;
+
+    // Stretch the box in the direction of travel
+    float dx = balls.vx[index] * AABB_VELOCITY_LOOKAHEAD;
+    float dy = balls.vy[index] * AABB_VELOCITY_LOOKAHEAD;
+    if (dx < 0.0f) box.minX += dx; else box.maxX += dx;
+    if (dy < 0.0f) box.minY += dy; else box.maxY += dy;
+    return box;
+}
+
+void DynamicAabbTree::findPairs(
+    const BallStore& balls,
+    const Container&,
+    std::vector<std::pair<size_t, size_t>>& outPairs)
+{
+    outPairs.clear();
+    ++step;
+    reinsertCount = 0;
+
+    size_t count = balls.size();
+
+    // Refresh or reinsert the leaf of every known ball. Leaves are keyed by
+    // ball id because BallStore indices shift when balls are removed.
+    newBalls.clear();
+    for (size_t i = 0; i < count; ++i) {
+        auto it = leafById.find(balls.id[i]);
+        if (it == leafById.end()) {
+            newBalls.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+
+        int leaf = it->second;
+        if (!nodes[leaf].box.contains(tightBox(balls, i))) {
+            removeLeaf(leaf);
+            nodes[leaf].box = fatBox(balls, i);
+            insertLeaf(leaf);
+            ++reinsertCount;
+        }
+        nodes[leaf].ballIndex = static_cast<uint32_t>(i);
+        nodes[leaf].lastStep = step;
+    }
+
+    // Insert new balls in Morton order: spatially coherent insertion builds a
+    // much tighter tree than store order when many balls arrive at once
+    sortByMortonCode(balls, newBalls);
+    for (uint32_t i : newBalls) {
+        int leaf = allocateNode();
+        nodes[leaf].box = fatBox(balls, i);
+        nodes[leaf].ballIndex = i;
+        nodes[leaf].lastStep = step;
+        insertLeaf(leaf);
+        leafById.emplace(balls.id[i], leaf);
+    }
+
+    if (leafById.size() > count) {
+        removeStaleLeaves();
+    }
+
+    if (root == NULL_NODE) {
+        return;
+    }
+
+    // Collide the tree with itself: descend into every pair of overlapping
+    // subtrees (a == b means "pairs inside this subtree"). Internal nodes use
+    // fat boxes; leaves are compared with tight boxes so only real AABB
+    // overlaps are reported.
+    pairStack.clear();
+    pairStack.emplace_back(root, root);
+
+    while (!pairStack.empty()) {
+        auto [a, b] = pairStack.back();
+        pairStack.pop_back();
+        const Node& nodeA = nodes[a];
+        const Node& nodeB = nodes[b];
+
+        if (a == b) {
+            if (!nodeA.isLeaf()) {
+                pairStack.emplace_back(nodeA.child1, nodeA.child1);
+                pairStack.emplace_back(nodeA.child2, nodeA.child2);
+                pairStack.emplace_back(nodeA.child1, nodeA.child2);
+            }
+            continue;
+        }
+
+        if (!nodeA.box.overlaps(nodeB.box)) {
+            continue;
+        }
+
+        if (nodeA.isLeaf() && nodeB.isLeaf()) {
+            if (tightBox(balls, nodeA.ballIndex).overlaps(tightBox(balls, nodeB.ballIndex))) {
+                outPairs.emplace_back(
+                    std::min(nodeA.ballIndex, nodeB.ballIndex),
+                    std::max(nodeA.ballIndex, nodeB.ballIndex)
+                );
+            }
+        } else if (nodeB.isLeaf() || (!nodeA.isLeaf() && nodeA.height >= nodeB.height)) {
+            // Descend into the taller subtree
+            pairStack.emplace_back(nodeA.child1, b);
+            pairStack.emplace_back(nodeA.child2, b);
+        } else {
+            pairStack.emplace_back(a, nodeB.child1);
+            pairStack.emplace_back(a, nodeB.child2);
+        }
+    }
+}
+
+void DynamicAabbTree::sortByMortonCode(const BallStore& balls, std::vector<uint32_t>& indices) {
+    if (indices.size() < 2) {
+        return;
+    }
+
+    float minX = balls.x[indices[0]], maxX = minX;
+    float minY = balls.y[indices[0]], maxY = minY;
+    for (uint32_t i : indices) {
+        minX = std::min(minX, balls.x[i]);
+        maxX = std::max(maxX, balls.x[i]);
+        minY = std::min(minY, balls.y[i]);
+        maxY = std::max(maxY, balls.y[i]);
+    }
+
+    // Spread the low 16 bits of v so a zero bit sits between each pair
+    auto spreadBits = [](uint32_t v) {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+
+    float scaleX = 65535.0f / std::max(maxX - minX, 1.0f);
+    float scaleY = 65535.0f / std::max(maxY - minY, 1.0f);
+
+    mortonKeys.clear();
+    for (uint32_t i : indices) {
+        uint32_t qx = static_cast<uint32_t>((balls.x[i] - minX) * scaleX);
+        uint32_t qy = static_cast<uint32_t>((balls.y[i] - minY) * scaleY);
+        uint64_t code = spreadBits(qx) | (spreadBits(qy) << 1);
+        mortonKeys.push_back((code << 32) | i);
+    }
+    std::sort(mortonKeys.begin(), mortonKeys.end());
+
+    for (size_t k = 0; k < indices.size(); ++k) {
+        indices[k] = static_cast<uint32_t>(mortonKeys[k]);
+    }
+}
+
+void DynamicAabbTree::removeStaleLeaves() {
+    for (auto it = leafById.begin(); it != leafById.end();) {
+        if (nodes[it->second].lastStep != step) {
+            removeLeaf(it->second);
+            freeNode(it->second);
+            it = leafById.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int DynamicAabbTree::getHeight() const {
+    return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+int DynamicAabbTree::allocateNode() {
+    if (freeList == NULL_NODE) {
+        nodes.push_back(Node{});
+        freeList = static_cast<int>(nodes.size()) - 1;
+        nodes[freeList].parent = NULL_NODE;
+    }
+
+    int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node].parent = NULL_NODE;
+    nodes[node].child1 = NULL_NODE;
+    nodes[node].child2 = NULL_NODE;
+    nodes[node].height = 0;
+    nodes[node].ballIndex = 0;
+    nodes[node].lastStep = 0;
+    return node;
+}
+
+void DynamicAabbTree::freeNode(int node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+}
+
+void DynamicAabbTree::insertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest perimeter cost
+    Aabb leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        float area = nodes[index].box.perimeter();
+        float combinedArea = Aabb::combine(nodes[index].box, leafBox).perimeter();
+
+        // Cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child) {
+            float childCost = Aabb::combine(leafBox, nodes[child].box).perimeter();
+            if (!nodes[child].isLeaf()) {
+                childCost -= nodes[child].box.perimeter();
+            }
+            return childCost + inheritanceCost;
+        };
+
+        float cost1 = descendCost(child1);
+        float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    // Create a new parent joining the sibling and the leaf
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = Aabb::combine(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].child1 == sibling) {
+        nodes[oldParent].child1 = newParent;
+    } else {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    // Walk back up, rebalancing and refitting
+    refit(nodes[leaf].parent);
+}
+
+void DynamicAabbTree::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // Replace the parent with the sibling
+    if (nodes[grandParent].child1 == parent) {
+        nodes[grandParent].child1 = sibling;
+    } else {
+        nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+void DynamicAabbTree::refit(int node) {
+    while (node != NULL_NODE) {
+        node = balance(node);
+
+        int child1 = nodes[node].child1;
+        int child2 = nodes[node].child2;
+        nodes[node].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[node].box = Aabb::combine(nodes[child1].box, nodes[child2].box);
+
+        node = nodes[node].parent;
+    }
+}
+
+int DynamicAabbTree::balance(int iA) {
+    Node& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int iB = A.child1;
+    int iC = A.child2;
+    Node& B = nodes[iB];
+    Node& C = nodes[iC];
+
+    int heightDiff = C.height - B.height;
+
+    // Rotate C up
+    if (heightDiff > 1) {
+        int iF = C.child1;
+        int iG = C.child2;
+        Node& F = nodes[iF];
+        Node& G = nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent == NULL_NODE) {
+            root = iC;
+        } else if (nodes[C.parent].child1 == iA) {
+            nodes[C.parent].child1 = iC;
+        } else {
+            nodes[C.parent].child2 = iC;
+        }
+
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = Aabb::combine(B.box, G.box);
+            C.box = Aabb::combine(A.box, F.box);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = Aabb::combine(B.box, F.box);
+            C.box = Aabb::combine(A.box, G.box);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Rotate B up
+    if (heightDiff < -1) {
+        int iD = B.child1;
+        int iE = B.child2;
+        Node& D = nodes[iD];
+        Node& E = nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent == NULL_NODE) {
+            root = iB;
+        } else if (nodes[B.parent].child1 == iA) {
+            nodes[B.parent].child1 = iB;
+        } else {
+            nodes[B.parent].child2 = iB;
+        }
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = Aabb::combine(C.box, E.box);
+            B.box = Aabb::combine(A.box, D.box);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = Aabb::combine(C.box, D.box);
+            B.box = Aabb::combine(A.box, E.box);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
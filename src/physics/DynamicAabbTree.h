@@ -0,0 +1,89 @@
+#pragma once
+
+#include "IBroadphase.h"
+#include <cstdint>
+#include <unordered_map>
+
+// Dynamic bounding-volume tree broadphase.
+// Every ball owns a leaf holding a fattened AABB (margin plus a short velocity
+// look-ahead). A leaf is only removed and reinserted when the ball leaves its
+// fat box, so most steps just refresh indices. Internal nodes are kept
+// balanced with AVL-style rotations.
+//
+// Leaves are compared with tight boxes, so pair counts track the real contact
+// count even when balls of very different sizes are mixed.
+class DynamicAabbTree : public IBroadphase {
+public:
+    DynamicAabbTree();
+
+    void findPairs(
+        const BallStore& balls,
+        const Container& container,
+        std::vector<std::pair<size_t, size_t>>& outPairs
+    ) override;
+
+    BroadphaseType getType() const override { return BroadphaseType::AabbTree; }
+    const char* getName() const override { return "AABB tree"; }
+
+    // Diagnostics
+    int getHeight() const;
+    size_t getReinsertCount() const { return reinsertCount; }  // Leaves moved during the last update
+
+private:
+    struct Aabb {
+        float minX, minY, maxX, maxY;
+
+        bool contains(const Aabb& other) const {
+            return minX <= other.minX && minY <= other.minY
+                && maxX >= other.maxX && maxY >= other.maxY;
+        }
+
+        bool overlaps(const Aabb& other) const {
+            return minX <= other.maxX && other.minX <= maxX
+                && minY <= other.maxY && other.minY <= maxY;
+        }
+
+        float perimeter() const {
+            return 2.0f * ((maxX - minX) + (maxY - minY));
+        }
+
+        static Aabb combine(const Aabb& a, const Aabb& b);
+    };
+
+    static constexpr int NULL_NODE = -1;
+
+    struct Node {
+        Aabb box;
+        int parent;      // Doubles as the next link while on the free list
+        int child1;
+        int child2;
+        int height;      // Leaf = 0, free node = -1
+        uint32_t ballIndex;
+        uint32_t lastStep;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::vector<Node> nodes;
+    int root;
+    int freeList;
+    uint32_t step;
+    size_t reinsertCount;
+
+    std::unordered_map<uint32_t, int> leafById;  // Ball id -> leaf node
+    std::vector<std::pair<int, int>> pairStack;  // Subtree pairs still to test
+    std::vector<uint32_t> newBalls;              // Balls without a leaf yet
+    std::vector<uint64_t> mortonKeys;
+
+    static Aabb tightBox(const BallStore& balls, size_t index);
+    static Aabb fatBox(const BallStore& balls, size_t index);
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+    void refit(int node);
+    void sortByMortonCode(const BallStore& balls, std::vector<uint32_t>& indices);
+    void removeStaleLeaves();
+};
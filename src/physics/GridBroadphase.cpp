@@ -0,0 +1,46 @@
+#include "GridBroadphase.h"
+#include <algorithm>
+
+namespace {
+    // Lower bound for the grid cell size so an empty or degenerate scene
+    // never produces a huge grid
+    constexpr float MIN_GRID_CELL_SIZE = 4.0f;
+}
+
+void GridBroadphase::findPairs(
+    const BallStore& balls,
+    const Container& container,
+    std::vector<std::pair<size_t, size_t>>& outPairs)
+{
+    update(balls, container);
+    spatialGrid.getPotentialCollisions(balls, outPairs);
+}
+
+void GridBroadphase::update(const BallStore& balls, const Container& container) {
+    // Fit the grid to the current ball sizes and container
+    updateGridGeometry(balls, container);
+
+    spatialGrid.build(balls);
+}
+
+void GridBroadphase::updateGridGeometry(const BallStore& balls, const Container& container) {
+    // Cell size = largest live ball diameter, the smallest size for which
+    // checking the neighbouring cells finds every overlapping pair
+    float maxRadius = 0.0f;
+    for (float radius : balls.radius) {
+        maxRadius = std::max(maxRadius, radius);
+    }
+    float cellSize = std::max(2.0f * maxRadius, MIN_GRID_CELL_SIZE);
+
+    // Cover the container plus one cell, so balls touching the outer wall are inside
+    Vector2D center = container.getCenter();
+    float halfExtent = container.getRadius() + cellSize;
+
+    spatialGrid.setGeometry(
+        cellSize,
+        center.x - halfExtent,
+        center.y - halfExtent,
+        center.x + halfExtent,
+        center.y + halfExtent
+    );
+}
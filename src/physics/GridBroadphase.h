@@ -0,0 +1,28 @@
+#pragma once
+
+#include "IBroadphase.h"
+#include "SpatialGrid.h"
+
+// Uniform grid broadphase. Keeps the grid fitted to the largest live ball and
+// the container, then rebuilds it every step.
+class GridBroadphase : public IBroadphase {
+public:
+    void findPairs(
+        const BallStore& balls,
+        const Container& container,
+        std::vector<std::pair<size_t, size_t>>& outPairs
+    ) override;
+
+    // Fit and rebuild the grid without generating pairs (for callers that walk cells directly)
+    void update(const BallStore& balls, const Container& container);
+
+    BroadphaseType getType() const override { return BroadphaseType::Grid; }
+    const char* getName() const override { return "Grid"; }
+
+    const SpatialGrid& getGrid() const { return spatialGrid; }
+
+private:
+    SpatialGrid spatialGrid;
+
+    void updateGridGeometry(const BallStore& balls, const Container& container);
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../entities/BallStore.h"
+#include "../entities/Container.h"
+#include <utility>
+#include <vector>
+
+// Available broadphase backends (selectable at runtime through PhysicsEngine)
+enum class BroadphaseType {
+    Grid,
+    SweepAndPrune,
+    AabbTree
+};
+
+constexpr int BROADPHASE_TYPE_COUNT = 3;
+
+// Broadphase interface: finds candidate ball pairs that may be overlapping.
+// Implementations may keep state between calls (e.g. last frame's sort order).
+class IBroadphase {
+public:
+    virtual ~IBroadphase() = default;
+
+    // Refresh internal structures from the current ball state and write every
+    // candidate pair (each unordered pair at most once) to outPairs
+    virtual void findPairs(
+        const BallStore& balls,
+        const Container& container,
+        std::vector<std::pair<size_t, size_t>>& outPairs
+    ) = 0;
+
+    virtual BroadphaseType getType() const = 0;
+    virtual const char* getName() const = 0;
+};
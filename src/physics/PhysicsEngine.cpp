@@ -1,66 +1,478 @@
 #include "PhysicsEngine.h"
+#include "BatchNarrowphase.h"
+#include "DynamicAabbTree.h"
+#include "GridBroadphase.h"
+#include "SweepAndPrune.h"
+#include "../profiling/Profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+    // Below this many balls the thread hand-off costs more than it saves
+    constexpr size_t PARALLEL_MIN_BALLS = 2048;
+
+    // Checkerboard colour classes of the parallel path (3 columns x 2 rows)
+    constexpr int COLOR_COUNT = 6;
+
+    // The bulk contact filter needs no extra reach: every constraint is
+    // built before the solver moves anything
+    constexpr float CONTACT_MARGIN = 0.0f;
+
+    struct WallCircle {
+        float centerX;
+        float centerY;
+        float radiusSquared;
+    };
+
+    // Symplectic Euler: velocity first, then position from the new velocity
+    // (sleeping balls get no gravity and have zero velocity, so they stay put),
+    // plus the off-screen flag (same rule as BallStore::isOffScreen) and
+    // which side of the wall circle the center started on and whether it
+    // crossed it (needs the swept test).
+    // Restrict-qualified columns and a branch-free body let the compiler
+    // vectorize this; GCC does not when the pointers are locals in a member
+    void integrateColumns(
+        float* __restrict x,
+        float* __restrict y,
+        const float* __restrict vx,
+        float* __restrict vy,
+        const float* __restrict radius,
+        const uint8_t* __restrict asleep,
+        uint8_t* __restrict offScreen,
+        uint8_t* __restrict insideWall,
+        uint8_t* __restrict wallCrossings,
+        size_t count,
+        float deltaVelocity,
+        float deltaTime,
+        float screenWidth,
+        float screenHeight,
+        WallCircle wall)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            float awake = static_cast<float>(asleep[i] ^ 1);
+            float newVy = vy[i] + deltaVelocity * awake;
+            float newX = x[i] + vx[i] * deltaTime;
+            float newY = y[i] + newVy * deltaTime;
+            float r = radius[i];
+
+            float oldDx = x[i] - wall.centerX;
+            float oldDy = y[i] - wall.centerY;
+            float newDx = newX - wall.centerX;
+            float newDy = newY - wall.centerY;
+            int wasInside = oldDx * oldDx + oldDy * oldDy < wall.radiusSquared;
+            int isInside = newDx * newDx + newDy * newDy < wall.radiusSquared;
+
+            vy[i] = newVy;
+            x[i] = newX;
+            y[i] = newY;
+            offScreen[i] = static_cast<uint8_t>((newY - r < 0.0f) | (newY + r > screenHeight)
+                                              | (newX + r < 0.0f) | (newX - r > screenWidth));
+            insideWall[i] = static_cast<uint8_t>(wasInside);
+            wallCrossings[i] = static_cast<uint8_t>(wasInside ^ isInside);
+        }
+    }
+
+    // Exact test for one pair that passed the batch filter. An overlapping
+    // pair becomes a solver constraint and an island edge; touching a
+    // sleeping ball queues its island for waking
+    void addContact(
+        const BallStore& balls,
+        size_t a,
+        size_t b,
+        float restitution,
+        std::vector<ContactConstraint>& constraints,
+        std::vector<std::pair<size_t, size_t>>& touching,
+        std::vector<uint32_t>& wakeIslands)
+    {
+        ContactConstraint constraint;
+        if (!ContactSolver::makeConstraint(balls, a, b, restitution, constraint)) {
+            return;
+        }
+
+        constraints.push_back(constraint);
+        touching.emplace_back(a, b);
+        if (balls.asleep[a]) {
+            wakeIslands.push_back(balls.island[a]);
+        }
+        if (balls.asleep[b]) {
+            wakeIslands.push_back(balls.island[b]);
+        }
+    }
+
+    // Calls visit(i) for every nonzero flag, skipping clear flags eight at a time
+    template <typename Visitor>
+    void forEachFlagged(const std::vector<uint8_t>& flags, Visitor&& visit) {
+        size_t count = flags.size();
+        for (size_t i = 0; i < count; ++i) {
+            if ((i & 7) == 0 && i + 8 <= count) {
+                uint64_t word;
+                std::memcpy(&word, flags.data() + i, sizeof(word));
+                if (word == 0) {
+                    i += 7;
+                    continue;
+                }
+            }
+            if (flags[i]) {
+                visit(i);
+            }
+        }
+    }
+}
 
 PhysicsEngine::PhysicsEngine(float gravity)
     : gravity(gravity)
-    , spatialGrid(50.0f, 1024.0f, 768.0f)  // Cell size = 2 × ball diameter
+    , screenWidth(std::numeric_limits<float>::max())
+    , screenHeight(std::numeric_limits<float>::max())
+    , broadphase(std::make_unique<GridBroadphase>())
+    , pairCount(0)
+    , lastShapeVersion(0)
+    , lastGravity(gravity)
 {
 }
 
-void PhysicsEngine::update(std::vector<Ball>& balls, const Container& container, float deltaTime, float restitution) {
-    // Apply gravity to all balls
-    applyGravity(balls, deltaTime);
+void PhysicsEngine::setBroadphase(BroadphaseType type) {
+    if (type == broadphase->getType()) {
+        return;
+    }
+
+    switch (type) {
+        case BroadphaseType::Grid:
+            broadphase = std::make_unique<GridBroadphase>();
+            break;
+        case BroadphaseType::SweepAndPrune:
+            broadphase = std::make_unique<SweepAndPrune>();
+            break;
+        case BroadphaseType::AabbTree:
+            broadphase = std::make_unique<DynamicAabbTree>();
+            break;
+    }
+}
+
+void PhysicsEngine::setScreenBounds(float width, float height) {
+    screenWidth = width;
+    screenHeight = height;
+}
+
+void PhysicsEngine::setThreadCount(size_t threadCount) {
+    if (threadCount == getThreadCount()) {
+        return;
+    }
 
-    // Update ball positions based on velocity
-    updatePositions(balls, deltaTime);
+    if (threadCount <= 1) {
+        threadPool.reset();
+    } else {
+        threadPool = std::make_unique<ThreadPool>(threadCount);
+    }
+
+    threadCandidates.assign(getThreadCount(), {});
+    threadContacts.assign(getThreadCount(), {});
+    threadConstraints.assign(getThreadCount(), {});
+    threadTouching.assign(getThreadCount(), {});
+    threadWakeIslands.assign(getThreadCount(), {});
+    threadPairCounts.assign(getThreadCount(), 0);
+}
+
+void PhysicsEngine::update(BallStore& balls, const Container& container, float deltaTime, float restitution) {
+    // A resized wall or new gravity no longer holds a resting pile where it is
+    if (container.getShapeVersion() != lastShapeVersion || gravity != lastGravity) {
+        ProfileScope scope(ProfileZone::Sleep);
+        sleepTracker.wakeAll(balls);
+        lastShapeVersion = container.getShapeVersion();
+        lastGravity = gravity;
+    }
+
+    // Gravity, positions, off-screen and wall-crossing flags in one pass
+    integrate(balls, container, deltaTime);
+
+    // Balls that stepped over the wall are rewound to their first contact
+    handleWallCrossings(balls, container, deltaTime, restitution);
 
     // Handle all collisions
     handleCollisions(balls, container, restitution);
+
+    // Put settled islands to sleep
+    ProfileScope scope(ProfileZone::Sleep);
+    sleepTracker.update(balls, touching, gravity, deltaTime);
 }
 
-void PhysicsEngine::applyGravity(std::vector<Ball>& balls, float deltaTime) {
-    for (Ball& ball : balls) {
-        ball.applyGravity(gravity, deltaTime);
-    }
+void PhysicsEngine::integrate(BallStore& balls, const Container& container, float deltaTime) {
+    ProfileScope scope(ProfileZone::Integration);
+    Vector2D center = container.getCenter();
+    float radius = container.getRadius();
+    WallCircle wall{center.x, center.y, radius * radius};
+    insideWall.resize(balls.size());
+    wallCrossings.resize(balls.size());
+
+    // Gravity acts downward (positive Y direction)
+    integrateColumns(
+        balls.x.data(), balls.y.data(), balls.vx.data(), balls.vy.data(),
+        balls.radius.data(), balls.asleep.data(), balls.offScreen.data(), insideWall.data(), wallCrossings.data(), balls.size(),
+        gravity * deltaTime, deltaTime, screenWidth, screenHeight, wall);
+}
+
+void PhysicsEngine::handleWallCrossings(BallStore& balls, const Container& container, float deltaTime, float restitution) {
+    ProfileScope scope(ProfileZone::Container);
+
+    // A center that crossed the wall circle skipped past the discrete test's
+    // band (or would be pushed out the wrong side by it). Velocities are
+    // unchanged since integration, so the start of each path is exact.
+    forEachFlagged(wallCrossings, [&](size_t i) {
+        Vector2D end(balls.x[i], balls.y[i]);
+        Vector2D start(end.x - balls.vx[i] * deltaTime, end.y - balls.vy[i] * deltaTime);
+
+        SweepInfo sweep = CollisionDetector::sweepContainerCollision(container, start, end, balls.radius[i]);
+        if (sweep.hasCollision) {
+            CollisionResolver::resolveSweptWallCollision(balls, i, container, start, sweep, deltaTime, restitution);
+        }
+    });
 }
 
-void PhysicsEngine::updatePositions(std::vector<Ball>& balls, float deltaTime) {
-    for (Ball& ball : balls) {
-        ball.update(deltaTime);
+void PhysicsEngine::handleCollisions(BallStore& balls, const Container& container, float restitution) {
+    touching.clear();
+    wakeIslands.clear();
+    solver.beginStep();
+
+    // Ball-ball contacts
+    bool parallel = threadPool && broadphase->getType() == BroadphaseType::Grid && balls.size() >= PARALLEL_MIN_BALLS;
+    if (parallel) {
+        findBallContactsParallel(balls, container, restitution);
+    } else {
+        findBallContacts(balls, container, restitution);
+    }
+
+    // Wake piles that were hit or that the gap rotated under
+    {
+        ProfileScope scope(ProfileZone::Sleep);
+        sleepTracker.requestWake(wakeIslands);
+        sleepTracker.wakeInGap(balls, container);
+        sleepTracker.wakeQueued(balls);
+    }
+
+    // Ball-container contacts
+    findWallContacts(balls, container, restitution);
+
+    // Warm start from last step's impulses, then solve everything together
+    ProfileScope scope(ProfileZone::Solver);
+    solver.warmStart(balls);
+    if (parallel) {
+        solveContactsParallel(balls, container);
+    } else {
+        solveContacts(balls, container);
     }
+    solver.endStep();
 }
 
-void PhysicsEngine::handleCollisions(std::vector<Ball>& balls, const Container& container, float restitution) {
-    // Handle ball-ball collisions
-    handleBallBallCollisions(balls, restitution);
+void PhysicsEngine::findBallContacts(BallStore& balls, const Container& container, float restitution) {
+    // Get potential collision pairs (the grid is timed in two parts)
+    if (broadphase->getType() == BroadphaseType::Grid) {
+        GridBroadphase& gridBroadphase = static_cast<GridBroadphase&>(*broadphase);
+        {
+            ProfileScope scope(ProfileZone::GridBuild);
+            gridBroadphase.update(balls, container);
+        }
+        ProfileScope scope(ProfileZone::PairGeneration);
+        gridBroadphase.getGrid().getPotentialCollisions(balls, potentialCollisions);
+    } else {
+        ProfileScope scope(ProfileZone::PairGeneration);
+        broadphase->findPairs(balls, container, potentialCollisions);
+    }
+
+    // Pairs inside a sleeping pile need no narrowphase
+    ProfileScope scope(ProfileZone::Narrowphase);
+    if (sleepTracker.getSleepingCount() > 0) {
+        auto bothAsleep = [&](const std::pair<size_t, size_t>& pair) {
+            return balls.asleep[pair.first] && balls.asleep[pair.second];
+        };
+        potentialCollisions.erase(
+            std::remove_if(potentialCollisions.begin(), potentialCollisions.end(), bothAsleep),
+            potentialCollisions.end());
+    }
+
+    // Reject separated candidates in bulk, then build constraints for the survivors
+    pairCount = potentialCollisions.size();
+    contacts.clear();
+    BatchNarrowphase::findContacts(balls, potentialCollisions, CONTACT_MARGIN, contacts);
 
-    // Handle ball-container collisions
-    handleBallContainerCollisions(balls, container, restitution);
+    std::vector<ContactConstraint>& constraints = solver.getConstraints();
+    for (const auto& pair : contacts) {
+        addContact(balls, pair.first, pair.second, restitution, constraints, touching, wakeIslands);
+    }
 }
 
-void PhysicsEngine::handleBallBallCollisions(std::vector<Ball>& balls, float restitution) {
-    // Rebuild spatial grid
-    spatialGrid.clear();
-    for (size_t i = 0; i < balls.size(); ++i) {
-        spatialGrid.insertBall(i, balls[i].position);
+void PhysicsEngine::findBallContactsParallel(BallStore& balls, const Container& container, float restitution) {
+    GridBroadphase& gridBroadphase = static_cast<GridBroadphase&>(*broadphase);
+    {
+        ProfileScope scope(ProfileZone::GridBuild);
+        gridBroadphase.update(balls, container);
     }
 
-    // Get potential collision pairs
-    spatialGrid.getPotentialCollisions(balls, potentialCollisions);
+    ProfileScope scope(ProfileZone::Narrowphase);
+    const SpatialGrid& grid = gridBroadphase.getGrid();
+    int gridWidth = grid.getGridWidth();
+    int gridHeight = grid.getGridHeight();
+
+    size_t threadCount = threadPool->getThreadCount();
+    std::vector<ContactConstraint>& constraints = solver.getConstraints();
+    constraintRanges.assign(COLOR_COUNT * threadCount + 1, 0);
+
+    // Cell (cx, cy) only touches balls in columns cx-1..cx+1 and rows cy..cy+1,
+    // so cells 3 columns or 2 rows apart never share a ball. The 6 colour
+    // classes (cx mod 3, cy mod 2) are gathered one after another, the cells
+    // of one class concurrently. Constraints are stored by colour, then by
+    // thread slice, so each slice of a colour can be solved without locks.
+    // Every cell builds its constraints in a fixed order and slices are
+    // appended in cell order, so the result does not depend on the thread count.
+    for (int color = 0; color < COLOR_COUNT; ++color) {
+        int colorX = color % 3;
+        int colorY = color / 3;
+        int columns = (gridWidth - colorX + 2) / 3;
+        int rows = (gridHeight - colorY + 1) / 2;
+
+        if (columns > 0 && rows > 0) {
+            threadPool->parallelFor(static_cast<size_t>(columns) * rows, [&](size_t begin, size_t end, size_t thread) {
+                auto& candidates = threadCandidates[thread];
+                auto& cellContacts = threadContacts[thread];
+                auto& cellConstraints = threadConstraints[thread];
+                auto& cellTouching = threadTouching[thread];
+                auto& cellWakeIslands = threadWakeIslands[thread];
+
+                for (size_t k = begin; k < end; ++k) {
+                    int cx = colorX + 3 * static_cast<int>(k % columns);
+                    int cy = colorY + 2 * static_cast<int>(k / columns);
 
-    // Check only potential collisions
-    for (const auto& pair : potentialCollisions) {
-        CollisionInfo info = detector.checkBallCollision(balls[pair.first], balls[pair.second]);
-        if (info.hasCollision) {
-            resolver.resolveElasticCollision(balls[pair.first], balls[pair.second], info, restitution);
+                    candidates.clear();
+                    grid.forEachPairInCell(cx, cy, [&](uint32_t a, uint32_t b) {
+                        if (!(balls.asleep[a] && balls.asleep[b])) {
+                            candidates.emplace_back(a, b);
+                        }
+                    });
+
+                    threadPairCounts[thread] += candidates.size();
+                    cellContacts.clear();
+                    BatchNarrowphase::findContacts(balls, candidates, CONTACT_MARGIN, cellContacts);
+
+                    for (const auto& pair : cellContacts) {
+                        addContact(balls, pair.first, pair.second, restitution, cellConstraints, cellTouching, cellWakeIslands);
+                    }
+                }
+            });
+        }
+
+        for (size_t thread = 0; thread < threadCount; ++thread) {
+            constraintRanges[color * threadCount + thread] = constraints.size();
+            constraints.insert(constraints.end(), threadConstraints[thread].begin(), threadConstraints[thread].end());
+            threadConstraints[thread].clear();
         }
     }
+    constraintRanges[COLOR_COUNT * threadCount] = constraints.size();
+
+    // Merge per-thread island edges and wake requests (in thread order, so
+    // the result is the same for any thread count)
+    pairCount = 0;
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        pairCount += threadPairCounts[thread];
+        threadPairCounts[thread] = 0;
+        touching.insert(touching.end(), threadTouching[thread].begin(), threadTouching[thread].end());
+        wakeIslands.insert(wakeIslands.end(), threadWakeIslands[thread].begin(), threadWakeIslands[thread].end());
+        threadTouching[thread].clear();
+        threadWakeIslands[thread].clear();
+    }
+}
+
+void PhysicsEngine::findWallContacts(BallStore& balls, const Container& container, float restitution) {
+    ProfileScope scope(ProfileZone::Container);
+
+    // Flag wall contacts for every ball in one vectorized pass; only flagged
+    // balls pay for the full check (sqrt, normal, penetration)
+    BatchNarrowphase::flagWallContacts(balls, container, insideWall, wallFlags);
+
+    std::vector<ContactConstraint>& wallConstraints = solver.getWallConstraints();
+    forEachFlagged(wallFlags, [&](size_t i) {
+        // Sleeping balls are already resting against the wall
+        if (balls.asleep[i]) {
+            return;
+        }
+
+        ContactConstraint constraint;
+        if (ContactSolver::makeWallConstraint(balls, i, container, insideWall[i] != 0, restitution, constraint)) {
+            wallConstraints.push_back(constraint);
+        }
+    });
+}
+
+void PhysicsEngine::solveContacts(BallStore& balls, const Container& container) {
+    std::vector<ContactConstraint>& constraints = solver.getConstraints();
+    std::vector<ContactConstraint>& wallConstraints = solver.getWallConstraints();
+    ContactConstraint* begin = constraints.data();
+    ContactConstraint* end = begin + constraints.size();
+    ContactConstraint* wallBegin = wallConstraints.data();
+    ContactConstraint* wallEnd = wallBegin + wallConstraints.size();
+
+    for (int iteration = 0; iteration < solver.getIterations(); ++iteration) {
+        ContactSolver::solveVelocities(balls, begin, end);
+        ContactSolver::solveWallVelocities(balls, wallBegin, wallEnd);
+    }
+    ContactSolver::applyRestitution(balls, begin, end);
+    ContactSolver::applyWallRestitution(balls, wallBegin, wallEnd);
+
+    ContactSolver::correctPositions(balls, begin, end);
+    correctWallPositions(balls, container);
 }
 
-void PhysicsEngine::handleBallContainerCollisions(std::vector<Ball>& balls, const Container& container, float restitution) {
-    for (Ball& ball : balls) {
-        CollisionInfo info = detector.checkContainerCollision(ball, container);
-        if (info.hasCollision) {
-            resolver.resolveWallCollision(ball, info, restitution);
+void PhysicsEngine::solveContactsParallel(BallStore& balls, const Container& container) {
+    size_t threadCount = threadPool->getThreadCount();
+    std::vector<ContactConstraint>& constraints = solver.getConstraints();
+    std::vector<ContactConstraint>& wallConstraints = solver.getWallConstraints();
+
+    // Ball-ball: one parallelFor slot per stored (colour, thread) slice,
+    // colours one after another. Wall: a ball has at most one wall contact,
+    // so any split is lock-free
+    auto forEachSlice = [&](auto&& solveRange) {
+        for (int color = 0; color < COLOR_COUNT; ++color) {
+            threadPool->parallelFor(threadCount, [&](size_t begin, size_t end, size_t) {
+                for (size_t slice = begin; slice < end; ++slice) {
+                    size_t range = color * threadCount + slice;
+                    solveRange(constraints.data() + constraintRanges[range], constraints.data() + constraintRanges[range + 1]);
+                }
+            });
         }
+    };
+    auto forEachWallSlice = [&](auto&& solveRange) {
+        threadPool->parallelFor(wallConstraints.size(), [&](size_t begin, size_t end, size_t) {
+            solveRange(wallConstraints.data() + begin, wallConstraints.data() + end);
+        });
+    };
+
+    for (int iteration = 0; iteration < solver.getIterations(); ++iteration) {
+        forEachSlice([&](ContactConstraint* begin, ContactConstraint* end) {
+            ContactSolver::solveVelocities(balls, begin, end);
+        });
+        forEachWallSlice([&](ContactConstraint* begin, ContactConstraint* end) {
+            ContactSolver::solveWallVelocities(balls, begin, end);
+        });
     }
+    forEachSlice([&](ContactConstraint* begin, ContactConstraint* end) {
+        ContactSolver::applyRestitution(balls, begin, end);
+    });
+    forEachWallSlice([&](ContactConstraint* begin, ContactConstraint* end) {
+        ContactSolver::applyWallRestitution(balls, begin, end);
+    });
+
+    forEachSlice([&](ContactConstraint* begin, ContactConstraint* end) {
+        ContactSolver::correctPositions(balls, begin, end);
+    });
+    correctWallPositions(balls, container);
+}
+
+void PhysicsEngine::correctWallPositions(BallStore& balls, const Container& container) {
+    // Wall contacts again, from the corrected positions
+    BatchNarrowphase::flagWallContacts(balls, container, insideWall, wallFlags);
+
+    forEachFlagged(wallFlags, [&](size_t i) {
+        if (!balls.asleep[i]) {
+            ContactSolver::correctWallPosition(balls, container, i, insideWall[i] != 0);
+        }
+    });
 }
@@ -1,10 +1,14 @@
 #pragma once
 
-#include "../entities/Ball.h"
+#include "../entities/BallStore.h"
 #include "../entities/Container.h"
 #include "CollisionDetector.h"
 #include "CollisionResolver.h"
-#include "SpatialGrid.h"
+#include "ContactSolver.h"
+#include "IBroadphase.h"
+#include "SleepTracker.h"
+#include "ThreadPool.h"
+#include <memory>
 #include <vector>
 
 class PhysicsEngine {
@@ -12,23 +16,78 @@ public:
     PhysicsEngine(float gravity);
 
     // Main physics update
-    void update(std::vector<Ball>& balls, const Container& container, float deltaTime, float restitution);
+    void update(BallStore& balls, const Container& container, float deltaTime, float restitution);
 
     // Configuration
     void setGravity(float gravity) { this->gravity = gravity; }
     float getGravity() const { return gravity; }
 
+    // Screen rectangle for the off-screen flags written during integration
+    // (unbounded until set)
+    void setScreenBounds(float width, float height);
+
+    // Broadphase backend (can be switched between steps)
+    void setBroadphase(BroadphaseType type);
+    BroadphaseType getBroadphaseType() const { return broadphase->getType(); }
+    const IBroadphase& getBroadphase() const { return *broadphase; }
+
+    // Sleeping of settled piles (on by default)
+    void setSleepingEnabled(bool enabled) { sleepTracker.setEnabled(enabled); }
+    bool isSleepingEnabled() const { return sleepTracker.isEnabled(); }
+    size_t getSleepingCount() const { return sleepTracker.getSleepingCount(); }
+
+    // Velocity iterations of the ball-ball contact solver
+    void setSolverIterations(int iterations) { solver.setIterations(iterations); }
+    int getSolverIterations() const { return solver.getIterations(); }
+    size_t getContactCount() const { return solver.getContactCount(); }
+
+    // Candidate ball pairs handed to the narrowphase last step
+    size_t getPairCount() const { return pairCount; }
+
+    // Threads used for ball-ball resolution (1 = serial). The parallel path
+    // walks grid cells directly, so it only runs with the grid broadphase.
+    void setThreadCount(size_t threadCount);
+    size_t getThreadCount() const { return threadPool ? threadPool->getThreadCount() : 1; }
+
 private:
     float gravity;  // Pixels per second²
-    CollisionDetector detector;
-    CollisionResolver resolver;
-    SpatialGrid spatialGrid;
+    float screenWidth;
+    float screenHeight;
+    std::unique_ptr<IBroadphase> broadphase;
+    std::unique_ptr<ThreadPool> threadPool;
+    size_t pairCount;
+    SleepTracker sleepTracker;
+
+    // Container shape and gravity of the previous step; sleeping balls skip
+    // wall work, so piles are woken when either changes
+    uint32_t lastShapeVersion;
+    float lastGravity;
+    ContactSolver solver;
     std::vector<std::pair<size_t, size_t>> potentialCollisions;
+    std::vector<std::pair<size_t, size_t>> contacts;
+    std::vector<std::pair<size_t, size_t>> touching;  // Pairs that collided this step (island edges)
+    std::vector<uint32_t> wakeIslands;
+    std::vector<uint8_t> wallFlags;
+    std::vector<uint8_t> insideWall;     // Center was inside the wall circle at the start of the step
+    std::vector<uint8_t> wallCrossings;  // Center crossed the wall circle this step
+
+    // Per-thread scratch for the parallel path (cell candidates, contacts and constraints)
+    std::vector<std::vector<std::pair<size_t, size_t>>> threadCandidates;
+    std::vector<std::vector<std::pair<size_t, size_t>>> threadContacts;
+    std::vector<std::vector<ContactConstraint>> threadConstraints;
+    std::vector<size_t> constraintRanges;  // Constraint range of each (colour, thread) slice
+    std::vector<std::vector<std::pair<size_t, size_t>>> threadTouching;
+    std::vector<std::vector<uint32_t>> threadWakeIslands;
+    std::vector<size_t> threadPairCounts;
 
     // Update steps
-    void applyGravity(std::vector<Ball>& balls, float deltaTime);
-    void updatePositions(std::vector<Ball>& balls, float deltaTime);
-    void handleCollisions(std::vector<Ball>& balls, const Container& container, float restitution);
-    void handleBallBallCollisions(std::vector<Ball>& balls, float restitution);
-    void handleBallContainerCollisions(std::vector<Ball>& balls, const Container& container, float restitution);
+    void integrate(BallStore& balls, const Container& container, float deltaTime);
+    void handleWallCrossings(BallStore& balls, const Container& container, float deltaTime, float restitution);
+    void handleCollisions(BallStore& balls, const Container& container, float restitution);
+    void findBallContacts(BallStore& balls, const Container& container, float restitution);
+    void findBallContactsParallel(BallStore& balls, const Container& container, float restitution);
+    void findWallContacts(BallStore& balls, const Container& container, float restitution);
+    void solveContacts(BallStore& balls, const Container& container);
+    void solveContactsParallel(BallStore& balls, const Container& container);
+    void correctWallPositions(BallStore& balls, const Container& container);
 };
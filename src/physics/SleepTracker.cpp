@@ -0,0 +1,197 @@
+#include "SleepTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // A ball is resting below this speed (pixels/second). Under gravity a ball
+    // lying on the wall still picks up g * dt per step before the wall stops
+    // it, so the threshold never drops below twice that.
+    constexpr float SLEEP_SPEED = 15.0f;
+
+    // Time every ball of an island must rest before the island sleeps (seconds)
+    constexpr float SLEEP_TIME = 0.5f;
+
+    // Sleeping balls this close to the wall wake when the gap passes under them
+    constexpr float GAP_WAKE_MARGIN = 1.0f;
+
+    constexpr uint16_t NO_REST = std::numeric_limits<uint16_t>::max();
+}
+
+SleepTracker::SleepTracker()
+    : enabled(true)
+    , nextIsland(1)
+    , sleepingCount(0)
+{
+}
+
+void SleepTracker::setEnabled(bool enabled) {
+    this->enabled = enabled;
+}
+
+void SleepTracker::requestWake(const std::vector<uint32_t>& islands) {
+    wakeRequests.insert(wakeRequests.end(), islands.begin(), islands.end());
+}
+
+void SleepTracker::wakeQueued(BallStore& balls) {
+    if (!enabled) {
+        // Disabled: nothing may stay asleep
+        if (sleepingCount > 0) {
+            wakeAll(balls);
+        }
+        wakeRequests.clear();
+        return;
+    }
+
+    if (wakeRequests.empty()) {
+        return;
+    }
+
+    std::sort(wakeRequests.begin(), wakeRequests.end());
+    wakeRequests.erase(std::unique(wakeRequests.begin(), wakeRequests.end()), wakeRequests.end());
+
+    for (size_t i = 0; i < balls.size(); ++i) {
+        if (balls.asleep[i] && std::binary_search(wakeRequests.begin(), wakeRequests.end(), balls.island[i])) {
+            balls.asleep[i] = 0;
+            balls.restSteps[i] = 0;
+            balls.island[i] = 0;
+            --sleepingCount;
+        }
+    }
+
+    wakeRequests.clear();
+}
+
+void SleepTracker::wakeInGap(const BallStore& balls, const Container& container) {
+    if (!enabled || sleepingCount == 0 || !container.hasGapOpening()) {
+        return;
+    }
+
+    Vector2D center = container.getCenter();
+    float containerRadius = container.getRadius();
+
+    for (size_t i = 0; i < balls.size(); ++i) {
+        if (!balls.asleep[i]) {
+            continue;
+        }
+
+        float dx = balls.x[i] - center.x;
+        float dy = balls.y[i] - center.y;
+        float distanceSquared = dx * dx + dy * dy;
+        float reach = balls.radius[i] + GAP_WAKE_MARGIN;
+        float inner = std::max(containerRadius - reach, 0.0f);
+        float outer = containerRadius + reach;
+
+        if (distanceSquared > inner * inner && distanceSquared < outer * outer
+            && container.isDirectionInGap(dx, dy)) {
+            requestWake(balls.island[i]);
+        }
+    }
+}
+
+void SleepTracker::update(
+    BallStore& balls,
+    const std::vector<std::pair<size_t, size_t>>& touching,
+    float gravity,
+    float deltaTime)
+{
+    if (!enabled) {
+        return;
+    }
+
+    size_t count = balls.size();
+    float threshold = std::max(SLEEP_SPEED, 2.0f * std::fabs(gravity) * deltaTime);
+    float thresholdSquared = threshold * threshold;
+
+    // Rest is counted in steps, so the step count depends on the physics rate
+    int sleepSteps = std::clamp(static_cast<int>(std::ceil(SLEEP_TIME / deltaTime)), 1, NO_REST - 1);
+
+    // Rest counters for awake balls
+    bool anyRested = false;
+    sleepingCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (balls.asleep[i]) {
+            ++sleepingCount;
+            continue;
+        }
+
+        float speedSquared = balls.vx[i] * balls.vx[i] + balls.vy[i] * balls.vy[i];
+        uint16_t rest = balls.restSteps[i];
+        rest = speedSquared < thresholdSquared ? static_cast<uint16_t>(std::min<int>(rest + 1, sleepSteps)) : 0;
+        balls.restSteps[i] = rest;
+        anyRested |= rest >= sleepSteps;
+    }
+
+    if (!anyRested) {
+        return;
+    }
+
+    // Islands of awake balls through this step's contacts
+    parent.resize(count);
+    std::iota(parent.begin(), parent.end(), 0u);
+    for (const auto& pair : touching) {
+        if (balls.asleep[pair.first] || balls.asleep[pair.second]) {
+            continue;
+        }
+        uint32_t rootA = findRoot(static_cast<uint32_t>(pair.first));
+        uint32_t rootB = findRoot(static_cast<uint32_t>(pair.second));
+        if (rootA != rootB) {
+            parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+        }
+    }
+
+    // An island rests as long as its least rested member
+    islandRest.assign(count, NO_REST);
+    for (size_t i = 0; i < count; ++i) {
+        if (!balls.asleep[i]) {
+            uint32_t root = findRoot(static_cast<uint32_t>(i));
+            islandRest[root] = std::min(islandRest[root], balls.restSteps[i]);
+        }
+    }
+
+    // Roots come first in index order (parent is always the smaller index),
+    // so each sleeping island gets its label from its root
+    for (size_t i = 0; i < count; ++i) {
+        if (balls.asleep[i]) {
+            continue;
+        }
+
+        uint32_t root = findRoot(static_cast<uint32_t>(i));
+        if (islandRest[root] < sleepSteps) {
+            continue;
+        }
+
+        if (root == i) {
+            balls.island[i] = nextIsland++;
+            if (nextIsland == 0) {
+                nextIsland = 1;  // 0 means "no island"
+            }
+        } else {
+            balls.island[i] = balls.island[root];
+        }
+
+        balls.asleep[i] = 1;
+        balls.vx[i] = 0.0f;
+        balls.vy[i] = 0.0f;
+        ++sleepingCount;
+    }
+}
+
+uint32_t SleepTracker::findRoot(uint32_t index) {
+    // Path halving
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+void SleepTracker::wakeAll(BallStore& balls) {
+    for (size_t i = 0; i < balls.size(); ++i) {
+        balls.asleep[i] = 0;
+        balls.restSteps[i] = 0;
+        balls.island[i] = 0;
+    }
+    sleepingCount = 0;
+}
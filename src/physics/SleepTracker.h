@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../entities/BallStore.h"
+#include "../entities/Container.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Puts settled piles to sleep and wakes them again.
+// A ball counts as resting once its speed stays below a threshold; balls that
+// touched this step form islands (union-find over the contact pairs), and an
+// island sleeps only when every member has rested for SLEEP_TIME. Sleeping
+// balls keep an island label, so a disturbance wakes the whole pile at once.
+class SleepTracker {
+public:
+    SleepTracker();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    // Queue the island of a sleeping ball for waking (applied by wakeQueued)
+    void requestWake(uint32_t island) { wakeRequests.push_back(island); }
+    void requestWake(const std::vector<uint32_t>& islands);
+
+    // Wake every queued island in one pass over the balls
+    void wakeQueued(BallStore& balls);
+
+    // Queue sleeping islands the container gap has rotated under
+    void wakeInGap(const BallStore& balls, const Container& container);
+
+    // Wake every ball now and restart all rest counters (e.g. when the
+    // container or gravity changes under a resting pile)
+    void wakeAll(BallStore& balls);
+
+    // Update rest counters and put fully rested islands to sleep.
+    // touching: ball pairs that were in contact this step
+    void update(
+        BallStore& balls,
+        const std::vector<std::pair<size_t, size_t>>& touching,
+        float gravity,
+        float deltaTime
+    );
+
+    // Stats
+    size_t getSleepingCount() const { return sleepingCount; }
+
+private:
+    bool enabled;
+    uint32_t nextIsland;
+    size_t sleepingCount;
+    std::vector<uint32_t> wakeRequests;
+
+    // Union-find scratch (indexed by ball)
+    std::vector<uint32_t> parent;
+    std::vector<uint16_t> islandRest;
+
+    uint32_t findRoot(uint32_t index);
+};
@@ -2,77 +2,105 @@
 #include <algorithm>
 #include <cmath>
 
+SpatialGrid::SpatialGrid()
+    : SpatialGrid(1.0f, 1.0f, 1.0f)
+{
+}
+
 SpatialGrid::SpatialGrid(float cellSize, float worldWidth, float worldHeight)
     : cellSize(cellSize)
+    , originX(0.0f)
+    , originY(0.0f)
+    , outOfBoundsCount(0)
 {
-    gridWidth = static_cast<int>(std::ceil(worldWidth / cellSize));
-    gridHeight = static_cast<int>(std::ceil(worldHeight / cellSize));
-    cells.resize(gridWidth * gridHeight);
+    gridWidth = std::max(1, static_cast<int>(std::ceil(worldWidth / cellSize)));
+    gridHeight = std::max(1, static_cast<int>(std::ceil(worldHeight / cellSize)));
+    resizeCells();
 }
 
-void SpatialGrid::clear() {
-    for (auto& cell : cells) {
-        cell.clear();
+void SpatialGrid::setGeometry(float newCellSize, float minX, float minY, float maxX, float maxY) {
+    int newWidth = std::max(1, static_cast<int>(std::ceil((maxX - minX) / newCellSize)));
+    int newHeight = std::max(1, static_cast<int>(std::ceil((maxY - minY) / newCellSize)));
+
+    if (newCellSize == cellSize && minX == originX && minY == originY
+        && newWidth == gridWidth && newHeight == gridHeight) {
+        return;
     }
+
+    cellSize = newCellSize;
+    originX = minX;
+    originY = minY;
+    gridWidth = newWidth;
+    gridHeight = newHeight;
+    resizeCells();
+}
+
+void SpatialGrid::resizeCells() {
+    cellStart.resize(gridWidth * gridHeight + 1);
+    cellCursor.resize(gridWidth * gridHeight);
 }
 
-void SpatialGrid::insertBall(size_t ballIndex, const Vector2D& position) {
-    int cx = getCellX(position.x);
-    int cy = getCellY(position.y);
+void SpatialGrid::build(const BallStore& balls) {
+    size_t count = balls.size();
+    size_t cellCount = cellCursor.size();
+    ballCell.resize(count);
+    std::fill(cellStart.begin(), cellStart.end(), 0u);
+    outOfBoundsCount = 0;
+
+    // Pass 1: assign cells and count balls per cell (counts land in cellStart[c + 1])
+    for (size_t i = 0; i < count; ++i) {
+        int cx = getCellX(balls.x[i]);
+        int cy = getCellY(balls.y[i]);
 
-    if (cx >= 0 && cx < gridWidth && cy >= 0 && cy < gridHeight) {
-        cells[getCellIndex(cx, cy)].push_back(ballIndex);
+        // Clamping keeps neighbouring balls in the same or adjacent cells, so
+        // no collision is lost; edge cells just get more crowded.
+        if (cx < 0 || cx >= gridWidth || cy < 0 || cy >= gridHeight) {
+            ++outOfBoundsCount;
+            cx = std::clamp(cx, 0, gridWidth - 1);
+            cy = std::clamp(cy, 0, gridHeight - 1);
+        }
+
+        uint32_t cell = static_cast<uint32_t>(getCellIndex(cx, cy));
+        ballCell[i] = cell;
+        cellStart[cell + 1]++;
+    }
+
+    // Prefix sum: cellStart[c] becomes the first slot of cell c
+    for (size_t c = 0; c < cellCount; ++c) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    // Pass 2: scatter ball indices into their cell ranges
+    std::copy(cellStart.begin(), cellStart.end() - 1, cellCursor.begin());
+    sortedIndices.resize(cellStart[cellCount]);
+    for (size_t i = 0; i < count; ++i) {
+        sortedIndices[cellCursor[ballCell[i]]++] = static_cast<uint32_t>(i);
     }
 }
 
 void SpatialGrid::getPotentialCollisions(
-    const std::vector<Ball>&,
-    std::vector<std::pair<size_t, size_t>>& outPairs)
+    const BallStore&,
+    std::vector<std::pair<size_t, size_t>>& outPairs) const
 {
     outPairs.clear();
 
     // Check each cell and its neighbors
     for (int cy = 0; cy < gridHeight; ++cy) {
         for (int cx = 0; cx < gridWidth; ++cx) {
-            const auto& cell = cells[getCellIndex(cx, cy)];
-
-            // Check within same cell
-            for (size_t i = 0; i < cell.size(); ++i) {
-                for (size_t j = i + 1; j < cell.size(); ++j) {
-                    outPairs.emplace_back(cell[i], cell[j]);
-                }
-            }
-
-            // Check with adjacent cells (right, down, down-right, down-left)
-            const int dx[] = {1, 0, 1, -1};
-            const int dy[] = {0, 1, 1, 1};
-
-            for (int d = 0; d < 4; ++d) {
-                int nx = cx + dx[d];
-                int ny = cy + dy[d];
-
-                if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight) {
-                    const auto& neighborCell = cells[getCellIndex(nx, ny)];
-
-                    for (size_t i : cell) {
-                        for (size_t j : neighborCell) {
-                            outPairs.emplace_back(i, j);
-                        }
-                    }
-                }
-            }
+            forEachPairInCell(cx, cy, [&outPairs](uint32_t a, uint32_t b) {
+                outPairs.emplace_back(a, b);
+            });
         }
     }
 }
 
 int SpatialGrid::getCellX(float x) const {
-    return static_cast<int>(x / cellSize);
+    // Clamp in float space first so far-away balls cannot overflow the int cast
+    float cell = std::floor((x - originX) / cellSize);
+    return static_cast<int>(std::clamp(cell, -1.0f, static_cast<float>(gridWidth)));
 }
 
 int SpatialGrid::getCellY(float y) const {
-    return static_cast<int>(y / cellSize);
-}
-
-int SpatialGrid::getCellIndex(int cx, int cy) const {
-    return cy * gridWidth + cx;
+    float cell = std::floor((y - originY) / cellSize);
+    return static_cast<int>(std::clamp(cell, -1.0f, static_cast<float>(gridHeight)));
 }
@@ -1,31 +1,100 @@
 #pragma once
 
-#include "../entities/Ball.h"
+#include "../entities/BallStore.h"
+#include <cstdint>
+#include <utility>
 #include <vector>
-#include <unordered_map>
 
+// Uniform grid broadphase built with a two-pass counting sort.
+// build() counts balls per cell, prefix-sums the counts into cellStart and
+// scatters ball indices into one contiguous sortedIndices array, so the
+// balls of cell c are sortedIndices[cellStart[c] .. cellStart[c + 1]).
+// All buffers are reused between builds: no heap allocations in steady state.
+//
+// Balls outside the grid bounds are clamped into the nearest edge cell, so
+// they still find their neighbours; getOutOfBoundsCount() reports how many
+// were clamped on the last build.
 class SpatialGrid {
 public:
+    SpatialGrid();
     SpatialGrid(float cellSize, float worldWidth, float worldHeight);
 
-    // Clear and rebuild grid
-    void clear();
-    void insertBall(size_t ballIndex, const Vector2D& position);
+    // Change cell size and covered area. Buffers are only resized when the
+    // resulting geometry differs from the current one.
+    void setGeometry(float cellSize, float minX, float minY, float maxX, float maxY);
+
+    // Rebuild the grid from the current ball positions
+    void build(const BallStore& balls);
 
     // Get potential collision pairs
     void getPotentialCollisions(
-        const std::vector<Ball>& balls,
+        const BallStore& balls,
         std::vector<std::pair<size_t, size_t>>& outPairs
-    );
+    ) const;
+
+    // Call visit(a, b) for every candidate pair "owned" by cell (cx, cy): pairs
+    // inside the cell and with its right, down, down-right and down-left
+    // neighbours. Together the cells own every pair exactly once, and a cell
+    // only touches balls in columns cx-1..cx+1 and rows cy..cy+1.
+    template <typename Visitor>
+    void forEachPairInCell(int cx, int cy, Visitor&& visit) const {
+        int cell = getCellIndex(cx, cy);
+        uint32_t begin = cellStart[cell];
+        uint32_t end = cellStart[cell + 1];
+        if (begin == end) {
+            return;
+        }
+
+        // Check within same cell
+        for (uint32_t i = begin; i < end; ++i) {
+            for (uint32_t j = i + 1; j < end; ++j) {
+                visit(sortedIndices[i], sortedIndices[j]);
+            }
+        }
+
+        // Check with adjacent cells (right, down, down-right, down-left)
+        const int dx[] = {1, 0, 1, -1};
+        const int dy[] = {0, 1, 1, 1};
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + dx[d];
+            int ny = cy + dy[d];
+
+            if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight) {
+                int neighbor = getCellIndex(nx, ny);
+                uint32_t neighborBegin = cellStart[neighbor];
+                uint32_t neighborEnd = cellStart[neighbor + 1];
+
+                for (uint32_t i = begin; i < end; ++i) {
+                    for (uint32_t j = neighborBegin; j < neighborEnd; ++j) {
+                        visit(sortedIndices[i], sortedIndices[j]);
+                    }
+                }
+            }
+        }
+    }
+
+    float getCellSize() const { return cellSize; }
+    int getGridWidth() const { return gridWidth; }
+    int getGridHeight() const { return gridHeight; }
+
+    // Balls that fell outside the grid bounds during the last build
+    size_t getOutOfBoundsCount() const { return outOfBoundsCount; }
 
 private:
     float cellSize;
+    float originX, originY;
     int gridWidth, gridHeight;
+    size_t outOfBoundsCount;
+
+    std::vector<uint32_t> cellStart;      // gridWidth * gridHeight + 1 offsets
+    std::vector<uint32_t> cellCursor;     // Scatter write positions
+    std::vector<uint32_t> ballCell;       // Cell of each ball
+    std::vector<uint32_t> sortedIndices;  // Ball indices grouped by cell
 
-    // Grid cells store ball indices
-    std::vector<std::vector<size_t>> cells;
+    void resizeCells();
 
     int getCellX(float x) const;
     int getCellY(float y) const;
-    int getCellIndex(int cx, int cy) const;
+    int getCellIndex(int cx, int cy) const { return cy * gridWidth + cx; }
 };
@@ -0,0 +1,102 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // If more than 1/N of the entries are new, a full sort beats insertion sort
+    constexpr size_t FULL_SORT_FRACTION = 8;
+
+    // Id slot with no live ball
+    constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+}
+
+size_t SweepAndPrune::syncWithStore(const BallStore& balls) {
+    size_t ballCount = balls.size();
+    uint32_t minId = std::numeric_limits<uint32_t>::max();
+    uint32_t maxId = 0;
+    for (size_t i = 0; i < ballCount; ++i) {
+        minId = std::min(minId, balls.id[i]);
+        maxId = std::max(maxId, balls.id[i]);
+    }
+
+    indexById.assign(ballCount > 0 ? static_cast<size_t>(maxId - minId) + 1 : 0, INVALID_INDEX);
+    for (size_t i = 0; i < ballCount; ++i) {
+        indexById[balls.id[i] - minId] = static_cast<uint32_t>(i);
+    }
+
+    // Removing entries keeps the survivors in their old relative order, so
+    // the list stays nearly sorted no matter how the store compacted
+    known.assign(ballCount, 0);
+    sorted.erase(
+        std::remove_if(sorted.begin(), sorted.end(), [this, minId](Endpoint& e) {
+            size_t slot = static_cast<size_t>(e.id) - minId;
+            if (e.id < minId || slot >= indexById.size() || indexById[slot] == INVALID_INDEX) {
+                return true;
+            }
+            e.index = indexById[slot];
+            known[e.index] = 1;
+            return false;
+        }),
+        sorted.end()
+    );
+
+    size_t appended = 0;
+    for (size_t i = 0; i < ballCount; ++i) {
+        if (!known[i]) {
+            sorted.push_back(Endpoint{0.0f, 0.0f, 0.0f, 0.0f, balls.id[i], static_cast<uint32_t>(i)});
+            ++appended;
+        }
+    }
+    return appended;
+}
+
+void SweepAndPrune::findPairs(
+    const BallStore& balls,
+    const Container&,
+    std::vector<std::pair<size_t, size_t>>& outPairs)
+{
+    outPairs.clear();
+
+    size_t count = balls.size();
+    size_t appended = syncWithStore(balls);
+
+    // Refresh keys for the current positions
+    for (Endpoint& e : sorted) {
+        e.radius = balls.radius[e.index];
+        e.minX = balls.x[e.index] - e.radius;
+        e.maxX = balls.x[e.index] + e.radius;
+        e.y = balls.y[e.index];
+    }
+
+    // Restore the order: insertion sort when it is nearly sorted, full sort otherwise
+    if (appended * FULL_SORT_FRACTION > count) {
+        std::sort(sorted.begin(), sorted.end(), [](const Endpoint& a, const Endpoint& b) {
+            return a.minX < b.minX;
+        });
+    } else {
+        for (size_t i = 1; i < count; ++i) {
+            Endpoint key = sorted[i];
+            size_t j = i;
+            while (j > 0 && sorted[j - 1].minX > key.minX) {
+                sorted[j] = sorted[j - 1];
+                --j;
+            }
+            sorted[j] = key;
+        }
+    }
+
+    // Sweep: every ball whose interval starts before this one ends overlaps on X
+    for (size_t i = 0; i < count; ++i) {
+        const Endpoint& a = sorted[i];
+
+        for (size_t j = i + 1; j < count && sorted[j].minX <= a.maxX; ++j) {
+            const Endpoint& b = sorted[j];
+
+            // Prune on the Y axis as well
+            if (std::fabs(b.y - a.y) <= a.radius + b.radius) {
+                outPairs.emplace_back(a.index, b.index);
+            }
+        }
+    }
+}
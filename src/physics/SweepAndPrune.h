@@ -0,0 +1,45 @@
+#pragma once
+
+#include "IBroadphase.h"
+#include <cstdint>
+
+// Sort-and-sweep broadphase along the X axis.
+// The sorted order is kept from the previous step, so when balls move
+// coherently the insertion sort that restores it runs in near-linear time.
+// Entries are keyed by ball id and remapped to store indices every step,
+// since BallStore indices shift whenever a ball is removed.
+class SweepAndPrune : public IBroadphase {
+public:
+    void findPairs(
+        const BallStore& balls,
+        const Container& container,
+        std::vector<std::pair<size_t, size_t>>& outPairs
+    ) override;
+
+    BroadphaseType getType() const override { return BroadphaseType::SweepAndPrune; }
+    const char* getName() const override { return "Sweep and prune"; }
+
+private:
+    // Copy of the fields the sweep reads, so it never gathers from the store
+    struct Endpoint {
+        float minX;
+        float maxX;
+        float y;
+        float radius;
+        uint32_t id;
+        uint32_t index;  // Store index for the current step
+    };
+
+    // Balls ordered by the left edge of their bounding box
+    std::vector<Endpoint> sorted;
+
+    // Scratch for syncWithStore. Ball ids are handed out in increasing
+    // order, so live ids span a dense range: a flat table indexed by
+    // id - minId maps them to store indices without hashing
+    std::vector<uint32_t> indexById;
+    std::vector<uint8_t> known;
+
+    // Drop balls that left the store, remap the rest to their current index
+    // and append new balls; returns how many were appended
+    size_t syncWithStore(const BallStore& balls);
+};
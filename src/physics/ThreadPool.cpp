@@ -0,0 +1,84 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : currentJob(nullptr)
+    , currentCount(0)
+    , generation(0)
+    , pending(0)
+    , stopping(false)
+{
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const Job& job) {
+    if (count == 0) {
+        return;
+    }
+
+    if (workers.empty()) {
+        job(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        currentCount = count;
+        pending.store(workers.size(), std::memory_order_relaxed);
+        ++generation;
+    }
+    workAvailable.notify_all();
+
+    // The calling thread takes the first slice
+    runSlice(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this]() { return pending.load(std::memory_order_acquire) == 0; });
+    currentJob = nullptr;
+}
+
+void ThreadPool::runSlice(size_t threadIndex) {
+    size_t threads = getThreadCount();
+    size_t begin = currentCount * threadIndex / threads;
+    size_t end = currentCount * (threadIndex + 1) / threads;
+
+    if (begin < end) {
+        (*currentJob)(begin, end, threadIndex);
+    }
+}
+
+void ThreadPool::workerLoop(size_t threadIndex) {
+    uint64_t seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runSlice(threadIndex);
+
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            workDone.notify_one();
+        }
+    }
+}
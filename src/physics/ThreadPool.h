@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads for data-parallel physics passes.
+// parallelFor splits [0, count) into one contiguous slice per thread (the
+// calling thread takes slice 0) and blocks until every slice is done. The
+// split depends only on count and the thread count, so work assignment is
+// reproducible from run to run.
+class ThreadPool {
+public:
+    // threadCount includes the calling thread; 1 means run everything inline
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    // job(begin, end, threadIndex) is called once per non-empty slice
+    using Job = std::function<void(size_t begin, size_t end, size_t threadIndex)>;
+    void parallelFor(size_t count, const Job& job);
+
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+
+    const Job* currentJob;
+    size_t currentCount;
+    uint64_t generation;          // Bumped for every parallelFor call
+    std::atomic<size_t> pending;  // Worker slices still running
+    bool stopping;
+
+    void workerLoop(size_t threadIndex);
+    void runSlice(size_t threadIndex);
+};
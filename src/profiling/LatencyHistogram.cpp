@@ -0,0 +1,70 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+    : count(0)
+    , max(0)
+{
+    buckets.fill(0);
+}
+
+void LatencyHistogram::record(uint64_t microseconds) {
+    ++buckets[getBucketIndex(microseconds)];
+    ++count;
+    max = std::max(max, microseconds);
+}
+
+void LatencyHistogram::clear() {
+    buckets.fill(0);
+    count = 0;
+    max = 0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rank of the sample the percentile lands on (1-based)
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(getBucketUpperEdge(i), max);
+        }
+    }
+    return max;
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    // Highest set bit picks the power of two, the next SUB_BUCKET_BITS bits the sub-bucket
+    int exponent = 63;
+    while (!(value >> exponent)) {
+        --exponent;
+    }
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    int shift = exponent - SUB_BUCKET_BITS;
+    uint64_t subBucket = (value >> shift) - SUB_BUCKETS;
+    return static_cast<size_t>(SUB_BUCKETS + shift * SUB_BUCKETS + subBucket);
+}
+
+uint64_t LatencyHistogram::getBucketUpperEdge(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t subBucket = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    return ((SUB_BUCKETS + subBucket + 1) << shift) - 1;
+}
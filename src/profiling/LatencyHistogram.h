@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Log-bucketed latency histogram in the style of HdrHistogram: each power of
+// two of microseconds is split into SUB_BUCKETS linear buckets, so any
+// recorded value is reported within ~6% from 1us up to about 19 hours, in a
+// fixed 4KB with O(1) recording. Percentiles come from the cumulative counts
+// and report the upper edge of the bucket they fall in (the max is exact).
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t microseconds);
+    void clear();
+
+    uint64_t getCount() const { return count; }
+    uint64_t getMax() const { return max; }
+
+    // Smallest bucket edge at or below which this fraction (0..1) of samples fall
+    uint64_t getPercentile(double fraction) const;
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr uint64_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 36;  // 2^36 us
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    std::array<uint64_t, BUCKET_COUNT> buckets;
+    uint64_t count;
+    uint64_t max;
+
+    static size_t getBucketIndex(uint64_t value);
+    static uint64_t getBucketUpperEdge(size_t index);
+};
@@ -0,0 +1,115 @@
+#include "Profiler.h"
+#include <algorithm>
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : enabled(true)
+    , head(0)
+    , frameCount(0)
+{
+    for (auto& total : current) {
+        total.store(0, std::memory_order_relaxed);
+    }
+    for (auto& samples : history) {
+        samples.fill(0.0f);
+    }
+    frameHistory.fill(0.0f);
+}
+
+void Profiler::endFrame(double frameMs) {
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone) {
+        uint64_t nanoseconds = current[zone].exchange(0, std::memory_order_relaxed);
+        history[zone][head] = static_cast<float>(nanoseconds * 1e-6);
+    }
+    frameHistory[head] = static_cast<float>(frameMs);
+
+    head = (head + 1) % HISTORY;
+    ++frameCount;
+}
+
+double Profiler::getLastFrame(ProfileZone zone) const {
+    size_t last = (head + HISTORY - 1) % HISTORY;
+    return history[static_cast<size_t>(zone)][last];
+}
+
+Profiler::ZoneStats Profiler::getStats(ProfileZone zone) const {
+    return computeStats(history[static_cast<size_t>(zone)]);
+}
+
+Profiler::ZoneStats Profiler::getFrameStats() const {
+    return computeStats(frameHistory);
+}
+
+Profiler::ZoneStats Profiler::computeStats(const std::array<float, HISTORY>& samples) const {
+    size_t count = std::min(frameCount, HISTORY);
+    if (count == 0) {
+        return ZoneStats{0.0, 0.0, 0.0};
+    }
+
+    // Until the ring fills, the samples are slots [0, count)
+    std::array<float, HISTORY> sorted;
+    std::copy(samples.begin(), samples.begin() + count, sorted.begin());
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += sorted[i];
+    }
+
+    size_t rank = std::min(count - 1, (count * 99) / 100);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + count);
+    float p99 = sorted[rank];
+    float max = *std::max_element(sorted.begin() + rank, sorted.begin() + count);
+
+    return ZoneStats{sum / static_cast<double>(count), max, p99};
+}
+
+const char* Profiler::getZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::Events: return "Events";
+        case ProfileZone::Integration: return "Integration";
+        case ProfileZone::GridBuild: return "Grid build";
+        case ProfileZone::PairGeneration: return "Pairs";
+        case ProfileZone::Narrowphase: return "Narrowphase";
+        case ProfileZone::Container: return "Container";
+        case ProfileZone::Solver: return "Solver";
+        case ProfileZone::Sleep: return "Sleep";
+        case ProfileZone::BallManager: return "BallManager";
+        case ProfileZone::RenderBalls: return "Render balls";
+        case ProfileZone::RenderUI: return "Render UI";
+        case ProfileZone::Present: return "Present";
+        case ProfileZone::Count: break;
+    }
+    return "Unknown";
+}
+
+const char* Profiler::getZoneCategory(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::Events:
+            return "app";
+        case ProfileZone::Integration:
+        case ProfileZone::GridBuild:
+        case ProfileZone::PairGeneration:
+        case ProfileZone::Narrowphase:
+        case ProfileZone::Container:
+        case ProfileZone::Solver:
+        case ProfileZone::Sleep:
+            return "physics";
+        case ProfileZone::BallManager:
+            return "game";
+        case ProfileZone::RenderBalls:
+        case ProfileZone::RenderUI:
+        case ProfileZone::Present:
+            return "render";
+        case ProfileZone::Count:
+            break;
+    }
+    return "unknown";
+}
+
+bool Profiler::isSimulationZone(ProfileZone zone) {
+    return zone >= ProfileZone::Integration && zone <= ProfileZone::BallManager;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Tracer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Instrumented hot paths, in frame order (the overlay stacks them this way).
+// Integration through BallManager run on the simulation thread, concurrently
+// with the render-thread zones (see isSimulationZone)
+enum class ProfileZone : uint8_t {
+    Events,
+    Integration,
+    GridBuild,
+    PairGeneration,  // Counted under Narrowphase on the parallel path (pairs are made per cell)
+    Narrowphase,
+    Container,       // Swept wall crossings and wall contacts
+    Solver,
+    Sleep,
+    BallManager,
+    RenderBalls,
+    RenderUI,
+    Present,
+    Count
+};
+
+constexpr size_t PROFILE_ZONE_COUNT = static_cast<size_t>(ProfileZone::Count);
+
+// Per-frame zone timings. ProfileScope adds the time spent in a zone to the
+// current render frame (a zone entered several times, like the physics stages
+// over several fixed steps, sums up). Simulation zones hold what the
+// simulation thread spent while that frame ran, so they overlap the render
+// zones instead of adding to the frame time. endFrame() moves the totals into
+// a ring buffer of the last HISTORY frames, from which the overlay reads mean,
+// max and p99. Recording is a relaxed atomic add, so any thread may record.
+class Profiler {
+public:
+    static constexpr size_t HISTORY = 240;
+
+    struct ZoneStats {
+        double mean;  // Milliseconds per frame
+        double max;
+        double p99;
+    };
+
+    static Profiler& instance();
+
+    void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void record(ProfileZone zone, uint64_t nanoseconds) {
+        current[static_cast<size_t>(zone)].fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    // Close the frame: store every zone's total and the whole frame time
+    void endFrame(double frameMs);
+
+    // Milliseconds spent in a zone during the last closed frame
+    double getLastFrame(ProfileZone zone) const;
+
+    ZoneStats getStats(ProfileZone zone) const;
+    ZoneStats getFrameStats() const;
+
+    size_t getFrameCount() const { return frameCount; }
+
+    static const char* getZoneName(ProfileZone zone);
+    static const char* getZoneCategory(ProfileZone zone);  // Trace category
+
+    // True for zones recorded on the simulation thread
+    static bool isSimulationZone(ProfileZone zone);
+
+private:
+    Profiler();
+
+    std::atomic<bool> enabled;
+    std::array<std::atomic<uint64_t>, PROFILE_ZONE_COUNT> current;
+    std::array<std::array<float, HISTORY>, PROFILE_ZONE_COUNT> history;
+    std::array<float, HISTORY> frameHistory;
+    size_t head;        // Next history slot to write
+    size_t frameCount;  // Frames closed so far
+
+    ZoneStats computeStats(const std::array<float, HISTORY>& samples) const;
+};
+
+// Times the enclosing scope into a zone, and into the trace while tracing
+// is active (no clock reads while both are off)
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone)
+        : zone(zone)
+        , profiling(Profiler::instance().isEnabled())
+        , tracing(Tracer::instance().isActive())
+    {
+        if (profiling || tracing) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (!profiling && !tracing) {
+            return;
+        }
+
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        if (profiling) {
+            Profiler::instance().record(zone, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        }
+        if (tracing) {
+            Tracer::instance().complete(Profiler::getZoneName(zone), Profiler::getZoneCategory(zone), start, end);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone;
+    bool profiling;
+    bool tracing;
+    std::chrono::steady_clock::time_point start;
+};
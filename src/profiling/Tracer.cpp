@@ -0,0 +1,196 @@
+#include "Tracer.h"
+#include <iostream>
+
+namespace {
+    // How often the flush thread drains the rings
+    constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+    constexpr int PROCESS_ID = 1;
+}
+
+thread_local Tracer::ThreadBuffer* Tracer::threadBuffer = nullptr;
+thread_local const char* Tracer::threadName = nullptr;
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer()
+    : active(false)
+    , stopping(false)
+    , file(nullptr)
+    , firstEvent(true)
+{
+}
+
+Tracer::~Tracer() {
+    stop();
+}
+
+bool Tracer::start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(flushMutex);
+    if (file) {
+        return true;
+    }
+
+    file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    firstEvent = true;
+
+    // Forget anything left from an earlier session
+    {
+        std::lock_guard<std::mutex> buffersLock(buffersMutex);
+        for (auto& buffer : buffers) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->nameWritten = false;
+        }
+    }
+
+    epoch = Clock::now();
+    stopping = false;
+    active.store(true, std::memory_order_release);
+    flusher = std::thread(&Tracer::flushLoop, this);
+    return true;
+}
+
+void Tracer::stop() {
+    active.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        if (!file) {
+            return;
+        }
+        stopping = true;
+    }
+    flushSignal.notify_one();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+
+    std::lock_guard<std::mutex> lock(flushMutex);
+    drain();
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+    file = nullptr;
+
+    uint64_t dropped = 0;
+    std::lock_guard<std::mutex> buffersLock(buffersMutex);
+    for (auto& buffer : buffers) {
+        dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+    }
+    if (dropped > 0) {
+        std::cerr << "Trace dropped " << dropped << " events (ring buffer full)" << std::endl;
+    }
+}
+
+void Tracer::complete(const char* name, const char* category, Clock::time_point begin, Clock::time_point end) {
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - epoch).count();
+    event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    event.value = 0.0;
+    event.phase = 'X';
+    push(event);
+}
+
+void Tracer::counter(const char* name, double value) {
+    Event event;
+    event.name = name;
+    event.category = "counter";
+    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+    event.duration = 0;
+    event.value = value;
+    event.phase = 'C';
+    push(event);
+}
+
+void Tracer::setThreadName(const char* name) {
+    threadName = name;
+    if (threadBuffer) {
+        threadBuffer->threadName.store(name, std::memory_order_release);
+    }
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+    // Registered on the thread's first event; the ring lives as long as the tracer
+    if (!threadBuffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->threadName.store(threadName, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->threadId = static_cast<uint32_t>(buffers.size() + 1);
+        threadBuffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+    return *threadBuffer;
+}
+
+void Tracer::push(const Event& event) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    uint64_t tail = buffer.tail.load(std::memory_order_acquire);
+    if (head - tail >= RING_CAPACITY) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[head & (RING_CAPACITY - 1)] = event;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::flushLoop() {
+    std::unique_lock<std::mutex> lock(flushMutex);
+    while (!stopping) {
+        flushSignal.wait_for(lock, FLUSH_INTERVAL);
+        drain();
+        std::fflush(file);
+    }
+}
+
+void Tracer::drain() {
+    // Snapshot the list; rings are never freed, so the pointers stay valid
+    std::vector<ThreadBuffer*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto& buffer : buffers) {
+            snapshot.push_back(buffer.get());
+        }
+    }
+
+    for (ThreadBuffer* buffer : snapshot) {
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+        if (threadName && !buffer->nameWritten) {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                firstEvent ? "" : ",\n", PROCESS_ID, buffer->threadId, threadName);
+            firstEvent = false;
+            buffer->nameWritten = true;
+        }
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            writeEvent(*buffer, buffer->events[tail & (RING_CAPACITY - 1)]);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void Tracer::writeEvent(const ThreadBuffer& buffer, const Event& event) {
+    const char* separator = firstEvent ? "" : ",\n";
+    firstEvent = false;
+
+    double timestampUs = event.timestamp * 1e-3;
+    if (event.phase == 'C') {
+        std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,\"args\":{\"value\":%.17g}}",
+            separator, event.name, timestampUs, PROCESS_ID, event.value);
+    } else {
+        std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}",
+            separator, event.name, event.category, timestampUs, event.duration * 1e-3, PROCESS_ID, buffer.threadId);
+    }
+}
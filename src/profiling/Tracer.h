@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Chrome trace-event recorder (the JSON loads in Perfetto or chrome://tracing).
+// Every recording thread owns a fixed ring of events that only it writes and
+// only the flush thread reads (single producer, single consumer), so
+// recording takes no lock and never waits on file I/O. The flush thread
+// drains the rings a few times a second; if a ring fills up in between,
+// new events are dropped and counted rather than blocking.
+//
+// Names and categories must be string literals (only the pointer is stored).
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Tracer& instance();
+
+    // Open the output file and start the flush thread; false if the file
+    // cannot be written
+    bool start(const std::string& path);
+
+    // Flush everything recorded so far and close the file
+    void stop();
+
+    // Acquire pairs with the release in start(), so a thread that sees the
+    // tracer active also sees its epoch
+    bool isActive() const { return active.load(std::memory_order_acquire); }
+
+    // A finished slice on the calling thread
+    void complete(const char* name, const char* category, Clock::time_point begin, Clock::time_point end);
+
+    // A counter track sample
+    void counter(const char* name, double value);
+
+    // Label the calling thread in the trace viewer. Only remembered until the
+    // thread records its first event, so naming a thread costs no ring
+    void setThreadName(const char* name);
+
+private:
+    static constexpr size_t RING_CAPACITY = 16384;  // Events per thread, power of two
+
+    struct Event {
+        const char* name;
+        const char* category;
+        int64_t timestamp;  // Nanoseconds since start()
+        int64_t duration;
+        double value;
+        char phase;         // 'X' slice, 'C' counter
+    };
+
+    struct ThreadBuffer {
+        std::array<Event, RING_CAPACITY> events;
+        std::atomic<uint64_t> head{0};     // Written by the owning thread
+        std::atomic<uint64_t> tail{0};     // Written by the flush thread
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<const char*> threadName{nullptr};
+        uint32_t threadId = 0;
+        bool nameWritten = false;           // Flush thread only
+    };
+
+    Tracer();
+    ~Tracer();
+
+    std::atomic<bool> active;
+    Clock::time_point epoch;
+
+    // The calling thread's ring (null until it records) and pending name
+    static thread_local ThreadBuffer* threadBuffer;
+    static thread_local const char* threadName;
+
+    std::mutex buffersMutex;  // Guards the list, not the rings
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    std::mutex flushMutex;    // Guards the file and the flusher state
+    std::condition_variable flushSignal;
+    std::thread flusher;
+    bool stopping;
+    FILE* file;
+    bool firstEvent;
+
+    ThreadBuffer& getThreadBuffer();
+    void push(const Event& event);
+    void flushLoop();
+    void drain();  // Caller holds flushMutex
+    void writeEvent(const ThreadBuffer& buffer, const Event& event);
+};
+
+// Records the enclosing scope as a trace slice while tracing is active
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category)
+        : name(name)
+        , category(category)
+        , active(Tracer::instance().isActive())
+    {
+        if (active) {
+            begin = Tracer::Clock::now();
+        }
+    }
+
+    ~TraceScope() {
+        if (active) {
+            Tracer::instance().complete(name, category, begin, Tracer::Clock::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    bool active;
+    Tracer::Clock::time_point begin;
+};
@@ -0,0 +1,161 @@
+#include "CircleBatch.h"
+#include "CircleRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+    constexpr int ATLAS_WIDTH = 512;
+
+    // Transparent gutter around each sprite so neighbours never bleed in
+    constexpr int SPRITE_PADDING = 1;
+}
+
+CircleBatch::CircleBatch()
+    : atlas(nullptr)
+    , sprites()
+    , spriteExtents()
+    , atlasHeight(0)
+    , atlasUploaded(false)
+{
+}
+
+CircleBatch::~CircleBatch() {
+    cleanup();
+}
+
+bool CircleBatch::initialize(SDL_Renderer* renderer) {
+    if (!createAtlas(renderer)) {
+        std::cerr << "Circle atlas creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void CircleBatch::cleanup() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    atlasPixels.clear();
+    atlasUploaded = false;
+
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+}
+
+bool CircleBatch::createAtlas(SDL_Renderer* renderer) {
+    // Shelf packing in radius order; each shelf is as tall as its last sprite
+    std::array<SDL_Point, MAX_RADIUS + 1> origins = {};
+    int penX = SPRITE_PADDING;
+    int penY = SPRITE_PADDING;
+    int shelfHeight = 0;
+    for (int radius = 1; radius <= MAX_RADIUS; ++radius) {
+        int diameter = CircleRasterizer::getSpriteSize(static_cast<float>(radius));
+        if (penX + diameter + SPRITE_PADDING > ATLAS_WIDTH) {
+            penX = SPRITE_PADDING;
+            penY += shelfHeight + SPRITE_PADDING;
+            shelfHeight = 0;
+        }
+        origins[radius] = {penX, penY};
+        penX += diameter + SPRITE_PADDING;
+        shelfHeight = std::max(shelfHeight, diameter);
+    }
+    atlasHeight = penY + shelfHeight + SPRITE_PADDING;
+
+    for (int radius = 1; radius <= MAX_RADIUS; ++radius) {
+        SDL_Point origin = origins[radius];
+        int diameter = CircleRasterizer::getSpriteSize(static_cast<float>(radius));
+        spriteExtents[radius] = diameter * 0.5f / radius;
+
+        sprites[radius] = {
+            static_cast<float>(origin.x) / ATLAS_WIDTH,
+            static_cast<float>(origin.y) / atlasHeight,
+            static_cast<float>(diameter) / ATLAS_WIDTH,
+            static_cast<float>(diameter) / atlasHeight
+        };
+    }
+
+    atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, ATLAS_WIDTH, atlasHeight);
+    if (!atlas) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+
+    // Rasterize every sprite in place off the render thread; only the
+    // upload needs the renderer
+    atlasPixels.assign(static_cast<size_t>(ATLAS_WIDTH) * atlasHeight, 0);
+    worker = std::thread([this, origins]() {
+        for (int radius = 1; radius <= MAX_RADIUS; ++radius) {
+            SDL_Point origin = origins[radius];
+            CircleRasterizer::rasterize(
+                &atlasPixels[static_cast<size_t>(origin.y) * ATLAS_WIDTH + origin.x],
+                ATLAS_WIDTH,
+                static_cast<float>(radius)
+            );
+        }
+    });
+    return true;
+}
+
+void CircleBatch::uploadAtlas() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (SDL_UpdateTexture(atlas, nullptr, atlasPixels.data(), ATLAS_WIDTH * static_cast<int>(sizeof(uint32_t))) != 0) {
+        std::cerr << "Circle atlas upload failed: " << SDL_GetError() << std::endl;
+    }
+    atlasPixels = std::vector<uint32_t>();
+    atlasUploaded = true;
+}
+
+void CircleBatch::begin() {
+    vertices.clear();
+    indices.clear();
+}
+
+void CircleBatch::add(float x, float y, float radius, const SDL_Color& color) {
+    int spriteRadius = std::clamp(static_cast<int>(std::ceil(radius)), 1, MAX_RADIUS);
+    const SDL_FRect& uv = sprites[spriteRadius];
+
+    float extent = radius * spriteExtents[spriteRadius];
+    float left = x - extent;
+    float top = y - extent;
+    float right = x + extent;
+    float bottom = y + extent;
+    int base = static_cast<int>(vertices.size());
+
+    vertices.push_back({{left, top}, color, {uv.x, uv.y}});
+    vertices.push_back({{right, top}, color, {uv.x + uv.w, uv.y}});
+    vertices.push_back({{right, bottom}, color, {uv.x + uv.w, uv.y + uv.h}});
+    vertices.push_back({{left, bottom}, color, {uv.x, uv.y + uv.h}});
+
+    // Two triangles per quad
+    indices.push_back(base);
+    indices.push_back(base + 1);
+    indices.push_back(base + 2);
+    indices.push_back(base + 2);
+    indices.push_back(base + 3);
+    indices.push_back(base);
+}
+
+void CircleBatch::flush(SDL_Renderer* renderer) {
+    if (!atlas || vertices.empty()) {
+        return;
+    }
+    if (!atlasUploaded) {
+        uploadAtlas();
+    }
+
+    SDL_RenderGeometry(
+        renderer,
+        atlas,
+        vertices.data(),
+        static_cast<int>(vertices.size()),
+        indices.data(),
+        static_cast<int>(indices.size())
+    );
+    begin();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Draws many filled circles with a single SDL_RenderGeometry call.
+// Every integer radius up to MAX_RADIUS has an anti-aliased white circle
+// sprite (CircleRasterizer) in one atlas texture; each circle becomes a
+// textured quad whose vertex color tints the sprite. Quads are collected
+// between begin() and flush(), so a frame of balls is one draw call and no
+// texture switches.
+//
+// The sprites are rasterized on a worker thread started by initialize(),
+// overlapping the rest of startup; the first flush() uploads the atlas on
+// the render thread, waiting for the worker only if it has not finished.
+class CircleBatch {
+public:
+    // Larger circles stretch the largest sprite
+    static constexpr int MAX_RADIUS = 32;
+
+    CircleBatch();
+    ~CircleBatch();
+
+    // Create the atlas texture and start rasterizing its sprites
+    bool initialize(SDL_Renderer* renderer);
+    void cleanup();
+
+    // Start collecting a new batch (keeps the buffers' capacity)
+    void begin();
+
+    // Queue a circle (center and radius in pixels, sub-pixel positions kept)
+    void add(float x, float y, float radius, const SDL_Color& color);
+
+    // Draw every queued circle
+    void flush(SDL_Renderer* renderer);
+
+    size_t getCount() const { return vertices.size() / 4; }
+
+private:
+    SDL_Texture* atlas;
+
+    // Normalized atlas rect of the sprite for each radius (index 0 unused)
+    std::array<SDL_FRect, MAX_RADIUS + 1> sprites;
+
+    // Half the sprite's width per pixel of radius (sprites have a border)
+    std::array<float, MAX_RADIUS + 1> spriteExtents;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    // Atlas rasterization
+    std::thread worker;
+    std::vector<uint32_t> atlasPixels;  // Written by the worker until uploaded
+    int atlasHeight;
+    bool atlasUploaded;
+
+    // Place the sprites and create the (empty) atlas texture
+    bool createAtlas(SDL_Renderer* renderer);
+
+    // Wait for the worker and upload its pixels
+    void uploadAtlas();
+};
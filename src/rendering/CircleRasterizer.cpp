@@ -0,0 +1,93 @@
+#include "CircleRasterizer.h"
+#include "../math/MathUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__)
+#define MARBLE_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Packed RGBA8888 white; the alpha byte holds the coverage
+    constexpr uint32_t WHITE = 0xFFFFFF00u;
+
+    inline uint32_t shade(float dx, float dySquared, float edge) {
+        float coverage = std::clamp(edge - std::sqrt(dx * dx + dySquared), 0.0f, 1.0f);
+        return WHITE | static_cast<uint32_t>(coverage * 255.0f + 0.5f);
+    }
+}
+
+int CircleRasterizer::getSpriteSize(float radius) {
+    return 2 * (static_cast<int>(std::ceil(std::max(radius, 0.5f))) + PADDING);
+}
+
+void CircleRasterizer::rasterize(uint32_t* pixels, int pitch, float radius) {
+    int size = getSpriteSize(radius);
+    float center = size * 0.5f;
+
+    // Coverage is 1 inside radius - 0.5 and 0 past radius + 0.5
+    float edge = radius + 0.5f;
+
+    for (int y = 0; y < size; ++y) {
+        float dy = y + 0.5f - center;
+        float dySquared = dy * dy;
+        uint32_t* row = pixels + static_cast<size_t>(y) * pitch;
+
+        int x = 0;
+#ifdef MARBLE_HAS_SSE2
+        // Four pixels per iteration: sqrt, clamp and pack without branches
+        const __m128 dySquaredLanes = _mm_set1_ps(dySquared);
+        const __m128 edgeLanes = _mm_set1_ps(edge);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128i white = _mm_set1_epi32(static_cast<int>(WHITE));
+        __m128 dx = _mm_setr_ps(0.5f - center, 1.5f - center, 2.5f - center, 3.5f - center);
+        const __m128 step = _mm_set1_ps(4.0f);
+
+        for (; x + 4 <= size; x += 4) {
+            __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), dySquaredLanes));
+            __m128 coverage = _mm_min_ps(_mm_max_ps(_mm_sub_ps(edgeLanes, distance), zero), one);
+            __m128i alpha = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(coverage, scale), half));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), _mm_or_si128(white, alpha));
+            dx = _mm_add_ps(dx, step);
+        }
+#endif
+        for (; x < size; ++x) {
+            row[x] = shade(x + 0.5f - center, dySquared, edge);
+        }
+    }
+}
+
+void CircleRasterizer::rasterizeRing(uint32_t* pixels, int pitch, float radius, float thickness, float gapAngleRad) {
+    int size = getSpriteSize(radius);
+    float center = size * 0.5f;
+    float outerEdge = radius + 0.5f;
+    float innerEdge = radius - thickness - 0.5f;
+    bool hasGap = !MathUtils::floatEquals(gapAngleRad, 0.0f) && !MathUtils::floatEquals(gapAngleRad, MathUtils::TWO_PI);
+
+    for (int y = 0; y < size; ++y) {
+        float dy = y + 0.5f - center;
+        uint32_t* row = pixels + static_cast<size_t>(y) * pitch;
+
+        for (int x = 0; x < size; ++x) {
+            float dx = x + 0.5f - center;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float coverage = std::clamp(std::min(outerEdge - distance, distance - innerEdge), 0.0f, 1.0f);
+
+            // Fade across the gap edges by the pixel's distance along the arc
+            if (hasGap && coverage > 0.0f) {
+                float angle = MathUtils::normalizeAngle(std::atan2(dy, dx));
+                float outside = angle >= gapAngleRad
+                    ? std::min(angle - gapAngleRad, MathUtils::TWO_PI - angle)
+                    : -std::min(angle, gapAngleRad - angle);
+                coverage *= std::clamp(outside * distance + 0.5f, 0.0f, 1.0f);
+            }
+
+            row[x] = WHITE | static_cast<uint32_t>(coverage * 255.0f + 0.5f);
+        }
+    }
+}
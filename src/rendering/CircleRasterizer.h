@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// CPU rasterizer for the circle sprites. Writes white discs with an
+// anti-aliased edge (coverage from the signed distance to the circle) as
+// packed RGBA8888, ready for one SDL_UpdateTexture. Has no SDL dependency.
+class CircleRasterizer {
+public:
+    // Transparent border around the disc, so the anti-aliased edge is not
+    // clipped; a sprite is getSpriteSize(radius) pixels square
+    static constexpr int PADDING = 1;
+
+    static int getSpriteSize(float radius);
+
+    // Disc of radius centred in a getSpriteSize(radius) square starting at
+    // pixels; pitch is the row stride in pixels
+    static void rasterize(uint32_t* pixels, int pitch, float radius);
+
+    // Ring between radius - thickness and radius in a getSpriteSize(radius)
+    // square, left open over [0, gapAngleRad) (radians clockwise from +X, as
+    // on screen). No gap at 0 or 2π, same as Container
+    static void rasterizeRing(uint32_t* pixels, int pitch, float radius, float thickness, float gapAngleRad);
+};
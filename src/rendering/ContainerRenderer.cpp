@@ -0,0 +1,72 @@
+#include "ContainerRenderer.h"
+#include "CircleRasterizer.h"
+#include "../math/MathUtils.h"
+#include <iostream>
+#include <vector>
+
+ContainerRenderer::ContainerRenderer()
+    : texture(nullptr)
+    , textureSize(0)
+    , cachedVersion(0)
+    , cachedThickness(0)
+{
+}
+
+ContainerRenderer::~ContainerRenderer() {
+    cleanup();
+}
+
+void ContainerRenderer::cleanup() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+void ContainerRenderer::render(
+    SDL_Renderer* renderer,
+    const Vector2D& center,
+    float radius,
+    float gapAngleRad,
+    float rotationRad,
+    uint32_t shapeVersion,
+    const SDL_Color& color,
+    int thickness)
+{
+    if (!texture || shapeVersion != cachedVersion || thickness != cachedThickness) {
+        if (!rebuild(renderer, radius, gapAngleRad, thickness)) {
+            return;
+        }
+        cachedVersion = shapeVersion;
+        cachedThickness = thickness;
+    }
+
+    SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(texture, color.a);
+
+    // Rotated about its centre; SDL angles are clockwise degrees, like screen angles
+    float half = textureSize * 0.5f;
+    SDL_FRect destRect = {center.x - half, center.y - half, static_cast<float>(textureSize), static_cast<float>(textureSize)};
+    SDL_RenderCopyExF(renderer, texture, nullptr, &destRect, MathUtils::radToDeg(rotationRad), nullptr, SDL_FLIP_NONE);
+}
+
+bool ContainerRenderer::rebuild(SDL_Renderer* renderer, float radius, float gapAngleRad, int thickness) {
+    int size = CircleRasterizer::getSpriteSize(radius);
+
+    // Reuse the texture while the size stays the same (e.g. gap changes)
+    if (!texture || size != textureSize) {
+        cleanup();
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, size, size);
+        if (!texture) {
+            std::cerr << "Container texture creation failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        textureSize = size;
+    }
+
+    std::vector<uint32_t> pixels(static_cast<size_t>(size) * size);
+    CircleRasterizer::rasterizeRing(pixels.data(), size, radius, static_cast<float>(thickness), gapAngleRad);
+    SDL_UpdateTexture(texture, nullptr, pixels.data(), size * static_cast<int>(sizeof(uint32_t)));
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include "../math/Vector2D.h"
+#include <cstdint>
+
+// Draws the gapped container ring from a cached texture. The ring is
+// rasterized once with its gap starting at angle 0 and only rebuilt when the
+// container's shape version changes; rotation is applied by
+// SDL_RenderCopyEx, so a frame is one copy instead of thousands of points.
+class ContainerRenderer {
+public:
+    ContainerRenderer();
+    ~ContainerRenderer();
+
+    void cleanup();
+
+    // Ring of radius (drawn inwards by thickness) with the gap from
+    // rotationRad to rotationRad + gapAngleRad. Rebuilds the texture when
+    // shapeVersion differs from the cached one
+    void render(
+        SDL_Renderer* renderer,
+        const Vector2D& center,
+        float radius,
+        float gapAngleRad,
+        float rotationRad,
+        uint32_t shapeVersion,
+        const SDL_Color& color,
+        int thickness
+    );
+
+private:
+    SDL_Texture* texture;
+    int textureSize;
+    uint32_t cachedVersion;
+    int cachedThickness;
+
+    bool rebuild(SDL_Renderer* renderer, float radius, float gapAngleRad, int thickness);
+};
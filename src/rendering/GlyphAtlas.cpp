@@ -0,0 +1,143 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    constexpr int ATLAS_WIDTH = 512;
+    constexpr int GLYPH_PADDING = 1;
+    constexpr size_t GLYPH_COUNT = GlyphAtlas::LAST_CHAR - GlyphAtlas::FIRST_CHAR + 1;
+}
+
+GlyphAtlas::GlyphAtlas()
+    : texture(nullptr)
+    , lineHeight(0)
+    , glyphs()
+{
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    cleanup();
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+    cleanup();
+    lineHeight = TTF_FontHeight(font);
+
+    // Render each glyph on its own and shelf-pack the surfaces
+    const SDL_Color white = {255, 255, 255, 255};
+    std::array<SDL_Surface*, GLYPH_COUNT> surfaces = {};
+    std::array<SDL_Point, GLYPH_COUNT> origins = {};
+    int penX = GLYPH_PADDING;
+    int penY = GLYPH_PADDING;
+    int shelfHeight = 0;
+
+    for (size_t i = 0; i < GLYPH_COUNT; ++i) {
+        char text[2] = {static_cast<char>(FIRST_CHAR + i), '\0'};
+        Glyph& glyph = glyphs[i];
+        glyph = Glyph{{0.0f, 0.0f, 0.0f, 0.0f}, 0, 0, 0, false};
+
+        int height = 0;
+        TTF_SizeText(font, text, &glyph.advance, &height);
+
+        SDL_Surface* surface = TTF_RenderText_Blended(font, text, white);
+        if (!surface) {
+            continue;
+        }
+        surfaces[i] = surface;
+
+        if (penX + surface->w + GLYPH_PADDING > ATLAS_WIDTH) {
+            penX = GLYPH_PADDING;
+            penY += shelfHeight + GLYPH_PADDING;
+            shelfHeight = 0;
+        }
+        origins[i] = {penX, penY};
+        penX += surface->w + GLYPH_PADDING;
+        shelfHeight = std::max(shelfHeight, surface->h);
+    }
+    int atlasHeight = penY + shelfHeight + GLYPH_PADDING;
+
+    // Copy (not blend) the glyphs so their coverage lands in the atlas alpha
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    for (size_t i = 0; i < GLYPH_COUNT; ++i) {
+        SDL_Surface* surface = surfaces[i];
+        if (!surface) {
+            continue;
+        }
+
+        if (atlasSurface) {
+            SDL_Rect dest = {origins[i].x, origins[i].y, surface->w, surface->h};
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surface, nullptr, atlasSurface, &dest);
+
+            Glyph& glyph = glyphs[i];
+            glyph.uv = {
+                static_cast<float>(dest.x) / ATLAS_WIDTH,
+                static_cast<float>(dest.y) / atlasHeight,
+                static_cast<float>(surface->w) / ATLAS_WIDTH,
+                static_cast<float>(surface->h) / atlasHeight
+            };
+            glyph.width = surface->w;
+            glyph.height = surface->h;
+            glyph.visible = true;
+        }
+        SDL_FreeSurface(surface);
+    }
+
+    if (!atlasSurface) {
+        std::cerr << "Glyph atlas creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!texture) {
+        std::cerr << "Glyph atlas upload failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void GlyphAtlas::cleanup() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::getGlyph(char c) const {
+    if (c < FIRST_CHAR || c > LAST_CHAR) {
+        c = '?';
+    }
+    return glyphs[static_cast<size_t>(c - FIRST_CHAR)];
+}
+
+int GlyphAtlas::layout(const char* text, std::vector<SDL_Vertex>& vertices) const {
+    const SDL_Color white = {255, 255, 255, 255};
+    int penX = 0;
+
+    for (const char* c = text; *c; ++c) {
+        const Glyph& glyph = getGlyph(*c);
+        if (glyph.visible) {
+            float left = static_cast<float>(penX);
+            float right = left + glyph.width;
+            float bottom = static_cast<float>(glyph.height);
+            const SDL_FRect& uv = glyph.uv;
+
+            vertices.push_back({{left, 0.0f}, white, {uv.x, uv.y}});
+            vertices.push_back({{right, 0.0f}, white, {uv.x + uv.w, uv.y}});
+            vertices.push_back({{right, bottom}, white, {uv.x + uv.w, uv.y + uv.h}});
+            vertices.push_back({{left, bottom}, white, {uv.x, uv.y + uv.h}});
+        }
+        penX += glyph.advance;
+    }
+    return penX;
+}
+
+int GlyphAtlas::measure(const char* text) const {
+    int width = 0;
+    for (const char* c = text; *c; ++c) {
+        width += getGlyph(*c).advance;
+    }
+    return width;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <array>
+#include <vector>
+
+// Every printable ASCII glyph of one font, rasterized once (white) into a
+// single texture. Text is laid out as one textured quad per glyph, so any
+// string can be drawn without creating surfaces or textures. Glyphs are
+// placed by their rendered width, without kerning.
+class GlyphAtlas {
+public:
+    static constexpr char FIRST_CHAR = ' ';
+    static constexpr char LAST_CHAR = '~';
+
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    // Rasterize the font's glyphs and upload the atlas
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    void cleanup();
+
+    bool isBuilt() const { return texture != nullptr; }
+    SDL_Texture* getTexture() const { return texture; }
+    int getLineHeight() const { return lineHeight; }
+
+    // Append four white vertices per visible glyph for text with its top-left
+    // at (0, 0); characters outside the atlas are drawn as '?'. Returns the width
+    int layout(const char* text, std::vector<SDL_Vertex>& vertices) const;
+
+    // Width layout() would return, without producing vertices
+    int measure(const char* text) const;
+
+private:
+    struct Glyph {
+        SDL_FRect uv;   // Normalized rect in the atlas
+        int width;      // Quad size (the rendered surface)
+        int height;
+        int advance;    // Pen movement to the next glyph
+        bool visible;   // False if the font rendered no surface (e.g. space)
+    };
+
+    SDL_Texture* texture;
+    int lineHeight;
+    std::array<Glyph, LAST_CHAR - FIRST_CHAR + 1> glyphs;
+
+    const Glyph& getGlyph(char c) const;
+};
@@ -0,0 +1,142 @@
+#include "ProfilerOverlay.h"
+#include "SdlColor.h"
+#include "../core/Config.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    constexpr int LINE_HEIGHT = 22;
+    constexpr int SWATCH_SIZE = 10;
+    constexpr int LABEL_OFFSET = 16;    // Past the colour swatch
+    constexpr int VALUES_OFFSET = 150;
+    constexpr int BAR_HEIGHT = 14;
+    constexpr int PADDING = 6;
+
+    // Re-rasterize the numbers this often (frames)
+    constexpr size_t REFRESH_FRAMES = 30;
+
+    // Full width of the bars, with a tick at one 60Hz frame
+    constexpr double BAR_SCALE_MS = 1000.0 / 30.0;
+    constexpr double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+    const SDL_Color BACKDROP_COLOR = {0, 0, 0, 170};
+    const SDL_Color IDLE_COLOR = {90, 90, 90, 255};
+    const SDL_Color BUDGET_COLOR = {255, 80, 80, 255};
+
+    // One colour per zone (ProfileZone order)
+    const SDL_Color ZONE_COLORS[PROFILE_ZONE_COUNT] = {
+        {150, 150, 255, 255},  // Events
+        {80, 200, 120, 255},   // Integration
+        {60, 160, 220, 255},   // Grid build
+        {40, 120, 200, 255},   // Pairs
+        {230, 200, 60, 255},   // Narrowphase
+        {200, 130, 60, 255},   // Container
+        {230, 80, 60, 255},    // Solver
+        {160, 100, 200, 255},  // Sleep
+        {200, 200, 200, 255},  // BallManager
+        {60, 220, 220, 255},   // Render balls
+        {240, 120, 200, 255},  // Render UI
+        {255, 255, 255, 255},  // Present
+    };
+}
+
+ProfilerOverlay::ProfilerOverlay()
+    : lines()
+    , lastRefreshFrame(0)
+{
+}
+
+void ProfilerOverlay::render(SDL_Renderer* renderer, TextRenderer& textRenderer, const Profiler& profiler, int x, int y) {
+    if (!lines[0].label || profiler.getFrameCount() - lastRefreshFrame >= REFRESH_FRAMES) {
+        refreshText(profiler);
+        lastRefreshFrame = profiler.getFrameCount();
+    }
+
+    int height = static_cast<int>(LINE_COUNT) * LINE_HEIGHT + 2 * BAR_HEIGHT + 4 * PADDING;
+    SDL_Rect backdrop = {x - PADDING, y - PADDING, Config::PROFILER_WIDTH + 2 * PADDING, height};
+    SDL_SetRenderDrawColor(renderer, BACKDROP_COLOR.r, BACKDROP_COLOR.g, BACKDROP_COLOR.b, BACKDROP_COLOR.a);
+    SDL_RenderFillRect(renderer, &backdrop);
+
+    SDL_Color textColor = toSDLColor(Config::TEXT_COLOR);
+    for (size_t i = 0; i < LINE_COUNT; ++i) {
+        int lineY = y + static_cast<int>(i) * LINE_HEIGHT;
+
+        // Zone lines get a swatch matching their bar segment
+        if (i >= 1 && i <= PROFILE_ZONE_COUNT) {
+            const SDL_Color& color = ZONE_COLORS[i - 1];
+            SDL_Rect swatch = {x, lineY + (LINE_HEIGHT - SWATCH_SIZE) / 2, SWATCH_SIZE, SWATCH_SIZE};
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_RenderFillRect(renderer, &swatch);
+        }
+
+        textRenderer.renderLabel(renderer, lines[i].label, x + LABEL_OFFSET, lineY, textColor);
+        textRenderer.renderText(renderer, lines[i].values, x + VALUES_OFFSET, lineY, textColor);
+    }
+    textRenderer.flush(renderer);
+
+    int barY = y + static_cast<int>(LINE_COUNT) * LINE_HEIGHT + PADDING;
+    renderZoneBar(renderer, profiler, x, barY, false);
+    renderZoneBar(renderer, profiler, x, barY + BAR_HEIGHT + PADDING, true);
+}
+
+void ProfilerOverlay::refreshText(const Profiler& profiler) {
+    char values[64];
+
+    setLine(0, "ms", "mean   max   p99");
+
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone) {
+        Profiler::ZoneStats stats = profiler.getStats(static_cast<ProfileZone>(zone));
+        snprintf(values, sizeof(values), "%5.2f %5.2f %5.2f", stats.mean, stats.max, stats.p99);
+        setLine(zone + 1, Profiler::getZoneName(static_cast<ProfileZone>(zone)), values);
+    }
+
+    Profiler::ZoneStats frame = profiler.getFrameStats();
+    snprintf(values, sizeof(values), "%5.2f %5.2f %5.2f", frame.mean, frame.max, frame.p99);
+    setLine(LINE_COUNT - 1, "Frame", values);
+}
+
+void ProfilerOverlay::setLine(size_t index, const char* label, const char* values) {
+    Line& line = lines[index];
+    line.label = label;
+    snprintf(line.values, sizeof(line.values), "%s", values);
+}
+
+void ProfilerOverlay::renderZoneBar(SDL_Renderer* renderer, const Profiler& profiler, int x, int y, bool simulation) {
+    double pixelsPerMs = Config::PROFILER_WIDTH / BAR_SCALE_MS;
+    int barEnd = x + Config::PROFILER_WIDTH;
+
+    // Render thread: whole frame first, zones stacked over it leave the idle
+    // part grey. The simulation bar has no frame to compare against
+    if (!simulation) {
+        double frameMs = profiler.getFrameStats().mean;
+        int frameWidth = std::min(static_cast<int>(frameMs * pixelsPerMs), Config::PROFILER_WIDTH);
+        SDL_Rect frameRect = {x, y, frameWidth, BAR_HEIGHT};
+        SDL_SetRenderDrawColor(renderer, IDLE_COLOR.r, IDLE_COLOR.g, IDLE_COLOR.b, IDLE_COLOR.a);
+        SDL_RenderFillRect(renderer, &frameRect);
+    }
+
+    double stackedMs = 0.0;
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone) {
+        if (Profiler::isSimulationZone(static_cast<ProfileZone>(zone)) != simulation) {
+            continue;
+        }
+
+        double meanMs = profiler.getStats(static_cast<ProfileZone>(zone)).mean;
+        int start = x + static_cast<int>(stackedMs * pixelsPerMs);
+        stackedMs += meanMs;
+        int end = std::min(x + static_cast<int>(stackedMs * pixelsPerMs), barEnd);
+        if (end <= start) {
+            continue;
+        }
+
+        const SDL_Color& color = ZONE_COLORS[zone];
+        SDL_Rect segment = {start, y, end - start, BAR_HEIGHT};
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(renderer, &segment);
+    }
+
+    // 60Hz budget tick
+    int budgetX = x + static_cast<int>(FRAME_BUDGET_MS * pixelsPerMs);
+    SDL_SetRenderDrawColor(renderer, BUDGET_COLOR.r, BUDGET_COLOR.g, BUDGET_COLOR.b, BUDGET_COLOR.a);
+    SDL_RenderDrawLine(renderer, budgetX, y - 2, budgetX, y + BAR_HEIGHT + 2);
+}
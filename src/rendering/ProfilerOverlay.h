@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../profiling/Profiler.h"
+#include "TextRenderer.h"
+#include <SDL2/SDL.h>
+#include <array>
+
+// Debug overlay for the Profiler: one line per zone with mean, max and p99
+// over the profiler's history, and two bars. The first stacks the render
+// thread's zones against the mean frame time (the uncovered rest is vsync
+// wait and untimed work); the second stacks the simulation zones, which run
+// concurrently on their own thread, on the same scale. The numbers are
+// reformatted every few frames, not every frame.
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+
+    void render(SDL_Renderer* renderer, TextRenderer& textRenderer, const Profiler& profiler, int x, int y);
+
+private:
+    // Name and numbers are drawn separately so the columns line up
+    struct Line {
+        const char* label;
+        char values[64];
+    };
+
+    static constexpr size_t LINE_COUNT = PROFILE_ZONE_COUNT + 2;  // Header, zones, frame
+
+    std::array<Line, LINE_COUNT> lines;
+    size_t lastRefreshFrame;
+
+    void refreshText(const Profiler& profiler);
+    void setLine(size_t index, const char* label, const char* values);
+    // Stack the mean times of the simulation or the render-thread zones
+    void renderZoneBar(SDL_Renderer* renderer, const Profiler& profiler, int x, int y, bool simulation);
+};
@@ -1,4 +1,5 @@
 #include "Renderer.h"
+#include "../profiling/Profiler.h"
 #include <iostream>
 
 Renderer::Renderer(int windowWidth, int windowHeight, const std::string& title)
@@ -42,11 +43,11 @@ bool Renderer::initialize() {
         return false;
     }
 
-    // Create renderer with hardware acceleration and vsync
+    // Create renderer with hardware acceleration, vsync and target textures (UI panel)
     renderer = SDL_CreateRenderer(
         window,
         -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE
     );
 
     if (!renderer) {
@@ -85,6 +86,7 @@ void Renderer::beginFrame() {
 }
 
 void Renderer::endFrame() {
+    ProfileScope scope(ProfileZone::Present);
     SDL_RenderPresent(renderer);
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SdlColor.h"
 #include <SDL2/SDL.h>
 #include <string>
 
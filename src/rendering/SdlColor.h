@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../entities/Color.h"
+#include <SDL2/SDL.h>
+
+// Simulation colors share SDL_Color's layout; convert at the SDL boundary
+inline SDL_Color toSDLColor(const Color& color) {
+    return SDL_Color{color.r, color.g, color.b, color.a};
+}
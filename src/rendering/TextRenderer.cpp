@@ -1,21 +1,32 @@
 #include "TextRenderer.h"
+#include "SdlColor.h"
 #include "../core/Config.h"
+#include <cmath>
+#include <cstdio>
+#include <functional>
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <string_view>
+
+namespace {
+    // Static labels are few; a full cache is simply cleared
+    constexpr size_t LABEL_CACHE_CAPACITY = 64;
+}
 
 TextRenderer::TextRenderer()
     : font(nullptr)
     , fontSize(Config::UI_FONT_SIZE)
     , initialized(false)
-    , fpsCachedTexture(nullptr)
+    , fpsText()
     , lastFPS(-1.0f)
-    , ballCountCachedTexture(nullptr)
+    , ballCountText()
     , lastBallCount(0)
-    , timerCachedTexture(nullptr)
+    , timerText()
     , lastTimerSeconds(-1)
-    , pendingRespawnCachedTexture(nullptr)
+    , pendingRespawnText()
     , lastPendingRespawnCount(0)
+    , frameTimeText()
+    , lastFrameP50(-1.0)
+    , lastFrameP99(-1.0)
 {
 }
 
@@ -23,7 +34,7 @@ TextRenderer::~TextRenderer() {
     cleanup();
 }
 
-bool TextRenderer::initialize() {
+bool TextRenderer::initialize(SDL_Renderer* renderer) {
     if (initialized) {
         return true;
     }
@@ -56,27 +67,29 @@ bool TextRenderer::initialize() {
         return false;
     }
 
+    // Every glyph is rasterized once, here
+    if (!glyphAtlas.build(renderer, font)) {
+        TTF_CloseFont(font);
+        font = nullptr;
+        TTF_Quit();
+        return false;
+    }
+
     initialized = true;
     return true;
 }
 
 void TextRenderer::cleanup() {
-    if (fpsCachedTexture) {
-        SDL_DestroyTexture(fpsCachedTexture);
-        fpsCachedTexture = nullptr;
-    }
-    if (ballCountCachedTexture) {
-        SDL_DestroyTexture(ballCountCachedTexture);
-        ballCountCachedTexture = nullptr;
-    }
-    if (timerCachedTexture) {
-        SDL_DestroyTexture(timerCachedTexture);
-        timerCachedTexture = nullptr;
-    }
-    if (pendingRespawnCachedTexture) {
-        SDL_DestroyTexture(pendingRespawnCachedTexture);
-        pendingRespawnCachedTexture = nullptr;
-    }
+    glyphAtlas.cleanup();
+    labelCache.clear();
+    vertices.clear();
+    indices.clear();
+    lastFPS = -1.0f;
+    lastBallCount = 0;
+    lastTimerSeconds = -1;
+    lastPendingRespawnCount = 0;
+    lastFrameP50 = -1.0;
+    lastFrameP99 = -1.0;
 
     if (font) {
         TTF_CloseFont(font);
@@ -90,48 +103,92 @@ void TextRenderer::cleanup() {
 }
 
 void TextRenderer::renderText(
-    SDL_Renderer* renderer,
-    const std::string& text,
+    SDL_Renderer*,
+    const char* text,
     int x, int y,
-    const SDL_Color& color,
-    int)
+    const SDL_Color& color)
 {
-    if (!initialized || !font) {
+    if (!initialized) {
         return;
     }
 
-    // Create surface from text
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!surface) {
+    layoutScratch.clear();
+    glyphAtlas.layout(text, layoutScratch);
+    queueLayout(layoutScratch, x, y, color);
+}
+
+void TextRenderer::renderLabel(SDL_Renderer*, const char* text, int x, int y, const SDL_Color& color) {
+    if (!initialized) {
         return;
     }
 
-    // Create texture from surface
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        SDL_FreeSurface(surface);
-        return;
+    size_t hash = std::hash<std::string_view>{}(text);
+    auto it = labelCache.find(hash);
+    if (it == labelCache.end() || it->second.text != text) {
+        if (labelCache.size() >= LABEL_CACHE_CAPACITY) {
+            labelCache.clear();
+        }
+        CachedLayout& layout = labelCache[hash];
+        layout.text = text;
+        layout.vertices.clear();
+        glyphAtlas.layout(text, layout.vertices);
+        it = labelCache.find(hash);
+    }
+
+    queueLayout(it->second.vertices, x, y, color);
+}
+
+void TextRenderer::queueLayout(const std::vector<SDL_Vertex>& layout, int x, int y, const SDL_Color& color) {
+    float offsetX = static_cast<float>(x);
+    float offsetY = static_cast<float>(y);
+
+    for (size_t i = 0; i < layout.size(); i += 4) {
+        int base = static_cast<int>(vertices.size());
+        for (size_t corner = 0; corner < 4; ++corner) {
+            SDL_Vertex vertex = layout[i + corner];
+            vertex.position.x += offsetX;
+            vertex.position.y += offsetY;
+            vertex.color = color;
+            vertices.push_back(vertex);
+        }
+
+        // Two triangles per glyph
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+        indices.push_back(base);
     }
+}
 
-    // Render texture
-    SDL_Rect destRect = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, nullptr, &destRect);
+void TextRenderer::flush(SDL_Renderer* renderer) {
+    if (vertices.empty()) {
+        return;
+    }
 
-    // Cleanup
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
+    SDL_RenderGeometry(
+        renderer,
+        glyphAtlas.getTexture(),
+        vertices.data(),
+        static_cast<int>(vertices.size()),
+        indices.data(),
+        static_cast<int>(indices.size())
+    );
+    vertices.clear();
+    indices.clear();
 }
 
 void TextRenderer::renderFPS(SDL_Renderer* renderer, float fps, int x, int y) {
-    std::ostringstream oss;
-    oss << "FPS: " << std::fixed << std::setprecision(1) << fps;
-    renderText(renderer, oss.str(), x, y, Config::TEXT_COLOR);
+    char text[32];
+    snprintf(text, sizeof(text), "FPS: %.1f", fps);
+    renderText(renderer, text, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
 void TextRenderer::renderBallCount(SDL_Renderer* renderer, size_t count, int x, int y) {
-    std::ostringstream oss;
-    oss << "Balls: " << count;
-    renderText(renderer, oss.str(), x, y, Config::TEXT_COLOR);
+    char text[32];
+    snprintf(text, sizeof(text), "Balls: %zu", count);
+    renderText(renderer, text, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
 void TextRenderer::renderTimer(SDL_Renderer* renderer, float elapsedTime, int x, int y) {
@@ -140,108 +197,56 @@ void TextRenderer::renderTimer(SDL_Renderer* renderer, float elapsedTime, int x,
     int seconds = static_cast<int>(elapsedTime) % 60;
     int milliseconds = static_cast<int>((elapsedTime - static_cast<int>(elapsedTime)) * 100);
 
-    std::ostringstream oss;
-    oss << "Time: "
-        << std::setfill('0') << std::setw(2) << minutes << ":"
-        << std::setfill('0') << std::setw(2) << seconds << "."
-        << std::setfill('0') << std::setw(2) << milliseconds;
-    renderText(renderer, oss.str(), x, y, Config::TEXT_COLOR);
+    char text[32];
+    snprintf(text, sizeof(text), "Time: %02d:%02d.%02d", minutes, seconds, milliseconds);
+    renderText(renderer, text, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
 void TextRenderer::renderFPSCached(SDL_Renderer* renderer, float fps, int x, int y) {
     // Only update if FPS changed significantly (> 1 FPS)
-    if (std::abs(fps - lastFPS) < 1.0f && fpsCachedTexture) {
-        SDL_Rect destRect;
-        SDL_QueryTexture(fpsCachedTexture, nullptr, nullptr, &destRect.w, &destRect.h);
-        destRect.x = x;
-        destRect.y = y;
-        SDL_RenderCopy(renderer, fpsCachedTexture, nullptr, &destRect);
-        return;
+    if (std::abs(fps - lastFPS) >= 1.0f) {
+        lastFPS = fps;
+        snprintf(fpsText, sizeof(fpsText), "FPS: %.1f", fps);
     }
-
-    lastFPS = fps;
-    std::ostringstream oss;
-    oss << "FPS: " << std::fixed << std::setprecision(1) << fps;
-    renderCachedTexture(renderer, &fpsCachedTexture, oss.str(), x, y);
+    renderText(renderer, fpsText, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
 void TextRenderer::renderBallCountCached(SDL_Renderer* renderer, size_t count, int x, int y) {
-    if (count == lastBallCount && ballCountCachedTexture) {
-        SDL_Rect destRect;
-        SDL_QueryTexture(ballCountCachedTexture, nullptr, nullptr, &destRect.w, &destRect.h);
-        destRect.x = x;
-        destRect.y = y;
-        SDL_RenderCopy(renderer, ballCountCachedTexture, nullptr, &destRect);
-        return;
+    if (count != lastBallCount || ballCountText[0] == '\0') {
+        lastBallCount = count;
+        snprintf(ballCountText, sizeof(ballCountText), "Balls: %zu", count);
     }
-
-    lastBallCount = count;
-    std::ostringstream oss;
-    oss << "Balls: " << count;
-    renderCachedTexture(renderer, &ballCountCachedTexture, oss.str(), x, y);
+    renderText(renderer, ballCountText, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
 void TextRenderer::renderTimerCached(SDL_Renderer* renderer, float elapsedTime, int x, int y) {
     int currentSeconds = static_cast<int>(elapsedTime);
 
     // Update every second
-    if (currentSeconds == lastTimerSeconds && timerCachedTexture) {
-        SDL_Rect destRect;
-        SDL_QueryTexture(timerCachedTexture, nullptr, nullptr, &destRect.w, &destRect.h);
-        destRect.x = x;
-        destRect.y = y;
-        SDL_RenderCopy(renderer, timerCachedTexture, nullptr, &destRect);
-        return;
-    }
-
-    lastTimerSeconds = currentSeconds;
-    int minutes = currentSeconds / 60;
-    int seconds = currentSeconds % 60;
-    int milliseconds = static_cast<int>((elapsedTime - currentSeconds) * 100);
-
-    std::ostringstream oss;
-    oss << "Time: "
-        << std::setfill('0') << std::setw(2) << minutes << ":"
-        << std::setfill('0') << std::setw(2) << seconds << "."
-        << std::setfill('0') << std::setw(2) << milliseconds;
-    renderCachedTexture(renderer, &timerCachedTexture, oss.str(), x, y);
+    if (currentSeconds != lastTimerSeconds) {
+        lastTimerSeconds = currentSeconds;
+        int minutes = currentSeconds / 60;
+        int seconds = currentSeconds % 60;
+        int milliseconds = static_cast<int>((elapsedTime - currentSeconds) * 100);
+        snprintf(timerText, sizeof(timerText), "Time: %02d:%02d.%02d", minutes, seconds, milliseconds);
+    }
+    renderText(renderer, timerText, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
 void TextRenderer::renderPendingRespawnCached(SDL_Renderer* renderer, size_t count, int x, int y) {
-    if (count == lastPendingRespawnCount && pendingRespawnCachedTexture) {
-        SDL_Rect destRect;
-        SDL_QueryTexture(pendingRespawnCachedTexture, nullptr, nullptr, &destRect.w, &destRect.h);
-        destRect.x = x;
-        destRect.y = y;
-        SDL_RenderCopy(renderer, pendingRespawnCachedTexture, nullptr, &destRect);
-        return;
+    if (count != lastPendingRespawnCount || pendingRespawnText[0] == '\0') {
+        lastPendingRespawnCount = count;
+        snprintf(pendingRespawnText, sizeof(pendingRespawnText), "Respawn Count: %zu", count);
     }
-
-    lastPendingRespawnCount = count;
-    std::ostringstream oss;
-    oss << "Respawn Count: " << count;
-    renderCachedTexture(renderer, &pendingRespawnCachedTexture, oss.str(), x, y);
+    renderText(renderer, pendingRespawnText, x, y, toSDLColor(Config::TEXT_COLOR));
 }
 
-void TextRenderer::renderCachedTexture(
-    SDL_Renderer* renderer,
-    SDL_Texture** cachedTexture,
-    const std::string& text,
-    int x, int y)
-{
-    // Destroy old texture
-    if (*cachedTexture) {
-        SDL_DestroyTexture(*cachedTexture);
+void TextRenderer::renderFrameTimeCached(SDL_Renderer* renderer, double p50Ms, double p99Ms, int x, int y) {
+    // Percentiles move in bucket steps, so the text changes rarely
+    if (p50Ms != lastFrameP50 || p99Ms != lastFrameP99) {
+        lastFrameP50 = p50Ms;
+        lastFrameP99 = p99Ms;
+        snprintf(frameTimeText, sizeof(frameTimeText), "Frame p50/p99: %.1f / %.1f ms", p50Ms, p99Ms);
     }
-
-    // Create new texture
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), Config::TEXT_COLOR);
-    if (!surface) return;
-
-    *cachedTexture = SDL_CreateTextureFromSurface(renderer, surface);
-
-    SDL_Rect destRect = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, *cachedTexture, nullptr, &destRect);
-
-    SDL_FreeSurface(surface);
+    renderText(renderer, frameTimeText, x, y, toSDLColor(Config::TEXT_COLOR));
 }
@@ -2,25 +2,41 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include "GlyphAtlas.h"
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+// Text is drawn as quads from a GlyphAtlas built once for the UI font.
+// The render calls only queue quads; flush() draws everything queued with a
+// single SDL_RenderGeometry call, so steady-state text creates no surfaces
+// or textures.
 class TextRenderer {
 public:
     TextRenderer();
     ~TextRenderer();
 
-    bool initialize();
+    bool initialize(SDL_Renderer* renderer);
     void cleanup();
 
-    // Render text at position
+    // Queue text at position (laid out on every call; for changing text).
+    // All text uses the atlas font size set at initialize()
     void renderText(
         SDL_Renderer* renderer,
-        const std::string& text,
+        const char* text,
         int x, int y,
-        const SDL_Color& color,
-        int fontSize = 24
+        const SDL_Color& color
     );
 
+    // Queue text whose layout is cached by string hash (for static labels)
+    void renderLabel(SDL_Renderer* renderer, const char* text, int x, int y, const SDL_Color& color);
+
+    // Draw everything queued since the last flush
+    void flush(SDL_Renderer* renderer);
+
+    int getLineHeight() const { return glyphAtlas.getLineHeight(); }
+    int measureText(const char* text) const { return glyphAtlas.measure(text); }
+
     // Render FPS counter
     void renderFPS(SDL_Renderer* renderer, float fps, int x, int y);
 
@@ -30,34 +46,50 @@ public:
     // Render elapsed time
     void renderTimer(SDL_Renderer* renderer, float elapsedTime, int x, int y);
 
-    // Cached rendering methods
+    // Cached rendering methods (text is only reformatted when the value changes)
     void renderFPSCached(SDL_Renderer* renderer, float fps, int x, int y);
     void renderBallCountCached(SDL_Renderer* renderer, size_t count, int x, int y);
     void renderTimerCached(SDL_Renderer* renderer, float elapsedTime, int x, int y);
     void renderPendingRespawnCached(SDL_Renderer* renderer, size_t count, int x, int y);
+    void renderFrameTimeCached(SDL_Renderer* renderer, double p50Ms, double p99Ms, int x, int y);
 
 private:
+    struct CachedLayout {
+        std::string text;
+        std::vector<SDL_Vertex> vertices;
+    };
+
     TTF_Font* font;
     int fontSize;
     bool initialized;
 
-    // Cached textures
-    SDL_Texture* fpsCachedTexture;
+    GlyphAtlas glyphAtlas;
+
+    // Quads queued for the next flush
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::vector<SDL_Vertex> layoutScratch;
+
+    // Static label layouts by string hash
+    std::unordered_map<size_t, CachedLayout> labelCache;
+
+    // Cached text
+    char fpsText[32];
     float lastFPS;
 
-    SDL_Texture* ballCountCachedTexture;
+    char ballCountText[32];
     size_t lastBallCount;
 
-    SDL_Texture* timerCachedTexture;
+    char timerText[32];
     int lastTimerSeconds;
 
-    SDL_Texture* pendingRespawnCachedTexture;
+    char pendingRespawnText[32];
     size_t lastPendingRespawnCount;
 
-    void renderCachedTexture(
-        SDL_Renderer* renderer,
-        SDL_Texture** cachedTexture,
-        const std::string& text,
-        int x, int y
-    );
+    char frameTimeText[64];
+    double lastFrameP50;
+    double lastFrameP99;
+
+    // Offset white layout vertices to (x, y), tint them and queue them
+    void queueLayout(const std::vector<SDL_Vertex>& layout, int x, int y, const SDL_Color& color);
 };
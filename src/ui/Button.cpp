@@ -1,4 +1,7 @@
 #include "Button.h"
+#include "../rendering/TextRenderer.h"
+#include "../rendering/SdlColor.h"
+#include "../core/Config.h"
 
 Button::Button(int x, int y, int width, int height, const std::string& label)
     : x(x)
@@ -15,24 +18,34 @@ Button::Button(int x, int y, int width, int height, const std::string& label)
 void Button::handleMouseDown(int mouseX, int mouseY) {
     if (containsPoint(mouseX, mouseY)) {
         pressed = true;
+        markDirty();
     }
 }
 
 void Button::handleMouseUp(int mouseX, int mouseY) {
-    if (pressed && containsPoint(mouseX, mouseY)) {
+    if (!pressed) {
+        return;
+    }
+    pressed = false;
+    markDirty();
+
+    if (containsPoint(mouseX, mouseY)) {
         // Button was clicked
         if (onClick) {
             onClick();
         }
     }
-    pressed = false;
 }
 
 void Button::handleMouseMove(int mouseX, int mouseY) {
-    hovered = containsPoint(mouseX, mouseY);
+    bool inside = containsPoint(mouseX, mouseY);
+    if (inside != hovered) {
+        hovered = inside;
+        markDirty();
+    }
 }
 
-void Button::render(SDL_Renderer* renderer) {
+void Button::render(SDL_Renderer* renderer, TextRenderer& textRenderer, int originX, int originY) {
     // Choose button color based on state
     SDL_Color buttonColor;
     if (pressed) {
@@ -45,14 +58,28 @@ void Button::render(SDL_Renderer* renderer) {
 
     // Draw button background
     SDL_SetRenderDrawColor(renderer, buttonColor.r, buttonColor.g, buttonColor.b, buttonColor.a);
-    SDL_Rect buttonRect = {x, y, width, height};
+    SDL_Rect buttonRect = {x - originX, y - originY, width, height};
     SDL_RenderFillRect(renderer, &buttonRect);
 
     // Draw button border
     SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
     SDL_RenderDrawRect(renderer, &buttonRect);
 
-    // Label will be rendered by TextRenderer in Application
+    // Draw label centred in the button
+    int labelX = buttonRect.x + (width - textRenderer.measureText(label.c_str())) / 2;
+    int labelY = buttonRect.y + (height - textRenderer.getLineHeight()) / 2;
+    textRenderer.renderLabel(renderer, label.c_str(), labelX, labelY, toSDLColor(Config::TEXT_COLOR));
+}
+
+SDL_Rect Button::getBounds() const {
+    return {x, y, width, height};
+}
+
+void Button::setLabel(const std::string& newLabel) {
+    if (newLabel != label) {
+        label = newLabel;
+        markDirty();
+    }
 }
 
 bool Button::containsPoint(int px, int py) const {
@@ -1,26 +1,30 @@
 #pragma once
 
-#include <SDL2/SDL.h>
+#include "Widget.h"
 #include <string>
 #include <functional>
 
-class Button {
+class Button : public Widget {
 public:
     Button(int x, int y, int width, int height, const std::string& label);
 
     // Handle mouse events
-    void handleMouseDown(int mouseX, int mouseY);
-    void handleMouseUp(int mouseX, int mouseY);
-    void handleMouseMove(int mouseX, int mouseY);
+    void handleMouseDown(int mouseX, int mouseY) override;
+    void handleMouseUp(int mouseX, int mouseY) override;
+    void handleMouseMove(int mouseX, int mouseY) override;
 
-    // Render the button
-    void render(SDL_Renderer* renderer);
+    // Render the button with its label centred
+    void render(SDL_Renderer* renderer, TextRenderer& textRenderer, int originX, int originY) override;
+
+    SDL_Rect getBounds() const override;
 
     // Set callback
     void setOnClick(std::function<void()> callback) { onClick = callback; }
 
+    void setLabel(const std::string& newLabel);
+
     // Check if point is inside button
-    bool containsPoint(int x, int y) const;
+    bool containsPoint(int x, int y) const override;
 
 private:
     int x, y;
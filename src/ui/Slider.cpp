@@ -1,6 +1,14 @@
 #include "Slider.h"
+#include "../rendering/TextRenderer.h"
+#include "../rendering/SdlColor.h"
+#include "../core/Config.h"
 #include <algorithm>
 
+namespace {
+    constexpr int HANDLE_HALF_WIDTH = 6;
+    constexpr int LABEL_OFFSET = 25;  // Label sits this far above the slider
+}
+
 Slider::Slider(int x, int y, int width, int height, float minValue, float maxValue, float initialValue)
     : x(x)
     , y(y)
@@ -10,39 +18,61 @@ Slider::Slider(int x, int y, int width, int height, float minValue, float maxVal
     , maxValue(maxValue)
     , value(initialValue)
     , dragging(false)
+    , hovered(false)
+    , labelFormatter(nullptr)
 {
 }
 
 void Slider::handleMouseDown(int mouseX, int mouseY) {
     if (containsPoint(mouseX, mouseY)) {
         dragging = true;
-        value = valueFromX(mouseX);
+        updateValue(valueFromX(mouseX));
+        markDirty();
     }
 }
 
-void Slider::handleMouseUp() {
-    dragging = false;
+void Slider::handleMouseUp(int mouseX, int mouseY) {
+    if (dragging) {
+        dragging = false;
+        hovered = containsPoint(mouseX, mouseY);
+        markDirty();
+    }
 }
 
-void Slider::handleMouseMove(int mouseX, int) {
+void Slider::handleMouseMove(int mouseX, int mouseY) {
     if (dragging) {
-        value = valueFromX(mouseX);
+        updateValue(valueFromX(mouseX));
+        return;
+    }
+
+    bool inside = containsPoint(mouseX, mouseY);
+    if (inside != hovered) {
+        hovered = inside;
+        markDirty();
     }
 }
 
-void Slider::render(SDL_Renderer* renderer, const std::string& label) {
+void Slider::render(SDL_Renderer* renderer, TextRenderer& textRenderer, int originX, int originY) {
+    int left = x - originX;
+    int top = y - originY;
+
     // Draw label above slider
-    // (Text rendering will be handled by TextRenderer in Application)
+    if (labelFormatter) {
+        char label[64];
+        labelFormatter(value, label, sizeof(label));
+        textRenderer.renderText(renderer, label, left, top - LABEL_OFFSET, toSDLColor(Config::TEXT_COLOR));
+    }
 
     // Draw slider track
     SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-    SDL_Rect trackRect = {x, y + height / 2 - 2, width, 4};
+    SDL_Rect trackRect = {left, top + height / 2 - 2, width, 4};
     SDL_RenderFillRect(renderer, &trackRect);
 
-    // Draw slider handle
-    int handleX = getHandleX();
-    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-    SDL_Rect handleRect = {handleX - 6, y, 12, height};
+    // Draw slider handle (brighter while hovered or dragged)
+    int handleX = getHandleX() - originX;
+    Uint8 shade = (hovered || dragging) ? 230 : 200;
+    SDL_SetRenderDrawColor(renderer, shade, shade, shade, 255);
+    SDL_Rect handleRect = {handleX - HANDLE_HALF_WIDTH, top, HANDLE_HALF_WIDTH * 2, height};
     SDL_RenderFillRect(renderer, &handleRect);
 
     // Draw handle outline
@@ -50,8 +80,12 @@ void Slider::render(SDL_Renderer* renderer, const std::string& label) {
     SDL_RenderDrawRect(renderer, &handleRect);
 }
 
+SDL_Rect Slider::getBounds() const {
+    return {x - HANDLE_HALF_WIDTH, y - LABEL_OFFSET, width + HANDLE_HALF_WIDTH * 2, height + LABEL_OFFSET};
+}
+
 void Slider::setValue(float newValue) {
-    value = std::clamp(newValue, minValue, maxValue);
+    updateValue(std::clamp(newValue, minValue, maxValue));
 }
 
 bool Slider::containsPoint(int px, int py) const {
@@ -73,3 +107,10 @@ float Slider::valueFromX(int mouseX) const {
     // Convert to value range
     return minValue + normalized * (maxValue - minValue);
 }
+
+void Slider::updateValue(float newValue) {
+    if (newValue != value) {
+        value = newValue;
+        markDirty();
+    }
+}
@@ -1,26 +1,34 @@
 #pragma once
 
-#include <SDL2/SDL.h>
-#include <string>
+#include "Widget.h"
+#include <cstddef>
+#include <functional>
 
-class Slider {
+class Slider : public Widget {
 public:
+    // Writes the label text for a value into buffer
+    using LabelFormatter = std::function<void(float value, char* buffer, size_t size)>;
+
     Slider(int x, int y, int width, int height, float minValue, float maxValue, float initialValue);
 
     // Handle mouse events
-    void handleMouseDown(int mouseX, int mouseY);
-    void handleMouseUp();
-    void handleMouseMove(int mouseX, int mouseY);
+    void handleMouseDown(int mouseX, int mouseY) override;
+    void handleMouseUp(int mouseX, int mouseY) override;
+    void handleMouseMove(int mouseX, int mouseY) override;
+
+    // Render the slider with its label above it
+    void render(SDL_Renderer* renderer, TextRenderer& textRenderer, int originX, int originY) override;
 
-    // Render the slider
-    void render(SDL_Renderer* renderer, const std::string& label);
+    SDL_Rect getBounds() const override;
 
     // Get/Set value
     float getValue() const { return value; }
     void setValue(float newValue);
 
+    void setLabelFormatter(LabelFormatter formatter) { labelFormatter = formatter; markDirty(); }
+
     // Check if point is inside slider
-    bool containsPoint(int x, int y) const;
+    bool containsPoint(int x, int y) const override;
 
 private:
     int x, y;
@@ -28,10 +36,15 @@ private:
     float minValue, maxValue;
     float value;
     bool dragging;
+    bool hovered;
+    LabelFormatter labelFormatter;
 
     // Calculate slider position from value
     int getHandleX() const;
 
     // Calculate value from mouse position
     float valueFromX(int mouseX) const;
+
+    // Change the value, marking the slider dirty if it moved
+    void updateValue(float newValue);
 };
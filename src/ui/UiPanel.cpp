@@ -0,0 +1,224 @@
+#include "UiPanel.h"
+#include "../rendering/TextRenderer.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    constexpr int CELL_SIZE = 32;
+}
+
+UiPanel::UiPanel()
+    : bounds{0, 0, 0, 0}
+    , target(nullptr)
+    , gridWidth(0)
+    , gridHeight(0)
+    , activeWidget(nullptr)
+    , hoveredWidget(nullptr)
+{
+}
+
+UiPanel::~UiPanel() {
+    cleanup();
+}
+
+void UiPanel::addWidget(Widget* widget) {
+    widgets.push_back(widget);
+}
+
+bool UiPanel::initialize(SDL_Renderer* renderer) {
+    cleanup();
+    if (widgets.empty()) {
+        return true;
+    }
+
+    bounds = widgets[0]->getBounds();
+    for (const Widget* widget : widgets) {
+        SDL_Rect widgetBounds = widget->getBounds();
+        SDL_UnionRect(&bounds, &widgetBounds, &bounds);
+    }
+    buildGrid();
+    invalidate();
+
+    // Without target support the widgets are drawn directly every frame
+    if (!SDL_RenderTargetSupported(renderer)) {
+        std::cerr << "Render targets unsupported, UI is redrawn every frame" << std::endl;
+        return true;
+    }
+
+    target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, bounds.w, bounds.h);
+    if (!target) {
+        std::cerr << "UI panel texture creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(target, SDL_BLENDMODE_BLEND);
+
+    // Start fully transparent; widgets only clear their own bounds
+    SDL_SetRenderTarget(renderer, target);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(renderer, nullptr);
+    return true;
+}
+
+void UiPanel::cleanup() {
+    if (target) {
+        SDL_DestroyTexture(target);
+        target = nullptr;
+    }
+}
+
+bool UiPanel::handleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_MOUSEBUTTONDOWN: {
+            activeWidget = hitTest(event.button.x, event.button.y);
+            if (!activeWidget) {
+                return false;
+            }
+            activeWidget->handleMouseDown(event.button.x, event.button.y);
+            return true;
+        }
+        case SDL_MOUSEBUTTONUP: {
+            if (!activeWidget) {
+                return false;
+            }
+            // Clear first: the release may run a callback that touches the panel
+            Widget* widget = activeWidget;
+            activeWidget = nullptr;
+            widget->handleMouseUp(event.button.x, event.button.y);
+            routeMotion(event.button.x, event.button.y);
+            return true;
+        }
+        case SDL_MOUSEMOTION:
+            routeMotion(event.motion.x, event.motion.y);
+            return activeWidget != nullptr || hoveredWidget != nullptr;
+        default:
+            return false;
+    }
+}
+
+void UiPanel::invalidate() {
+    for (Widget* widget : widgets) {
+        widget->markDirty();
+    }
+}
+
+void UiPanel::render(SDL_Renderer* renderer, TextRenderer& textRenderer) {
+    if (!target) {
+        for (Widget* widget : widgets) {
+            widget->render(renderer, textRenderer, 0, 0);
+            widget->clearDirty();
+        }
+        textRenderer.flush(renderer);
+        return;
+    }
+
+    bool redrawing = false;
+    for (Widget* widget : widgets) {
+        if (!widget->isDirty()) {
+            continue;
+        }
+        if (!redrawing) {
+            SDL_SetRenderTarget(renderer, target);
+            redrawing = true;
+        }
+
+        // Clear the widget's area to transparent and redraw it clipped there
+        SDL_Rect rect = widget->getBounds();
+        rect.x -= bounds.x;
+        rect.y -= bounds.y;
+        SDL_RenderSetClipRect(renderer, &rect);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderFillRect(renderer, &rect);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+        widget->render(renderer, textRenderer, bounds.x, bounds.y);
+        textRenderer.flush(renderer);
+        widget->clearDirty();
+    }
+    if (redrawing) {
+        SDL_RenderSetClipRect(renderer, nullptr);
+        SDL_SetRenderTarget(renderer, nullptr);
+    }
+
+    SDL_RenderCopy(renderer, target, nullptr, &bounds);
+}
+
+void UiPanel::buildGrid() {
+    gridWidth = (bounds.w + CELL_SIZE - 1) / CELL_SIZE;
+    gridHeight = (bounds.h + CELL_SIZE - 1) / CELL_SIZE;
+    size_t cellCount = static_cast<size_t>(gridWidth) * gridHeight;
+
+    // Cell range a widget's bounds overlap, relative to the panel
+    auto cellRange = [this](const Widget* widget, int& minX, int& minY, int& maxX, int& maxY) {
+        SDL_Rect rect = widget->getBounds();
+        minX = (rect.x - bounds.x) / CELL_SIZE;
+        minY = (rect.y - bounds.y) / CELL_SIZE;
+        maxX = std::min((rect.x + rect.w - bounds.x) / CELL_SIZE, gridWidth - 1);
+        maxY = std::min((rect.y + rect.h - bounds.y) / CELL_SIZE, gridHeight - 1);
+    };
+
+    // Count widgets per cell, prefix-sum, then scatter the indices
+    cellStart.assign(cellCount + 1, 0);
+    for (const Widget* widget : widgets) {
+        int minX, minY, maxX, maxY;
+        cellRange(widget, minX, minY, maxX, maxY);
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                ++cellStart[static_cast<size_t>(cy) * gridWidth + cx + 1];
+            }
+        }
+    }
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    cellWidgets.resize(cellStart[cellCount]);
+    std::vector<uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < widgets.size(); ++i) {
+        int minX, minY, maxX, maxY;
+        cellRange(widgets[i], minX, minY, maxX, maxY);
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                cellWidgets[cursor[static_cast<size_t>(cy) * gridWidth + cx]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+Widget* UiPanel::hitTest(int x, int y) const {
+    int localX = x - bounds.x;
+    int localY = y - bounds.y;
+    if (localX < 0 || localY < 0 || localX >= bounds.w || localY >= bounds.h) {
+        return nullptr;
+    }
+
+    size_t cell = static_cast<size_t>(localY / CELL_SIZE) * gridWidth + localX / CELL_SIZE;
+    for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+        Widget* widget = widgets[cellWidgets[i]];
+        if (widget->containsPoint(x, y)) {
+            return widget;
+        }
+    }
+    return nullptr;
+}
+
+void UiPanel::routeMotion(int x, int y) {
+    // A pressed widget gets every motion (slider drags)
+    if (activeWidget) {
+        activeWidget->handleMouseMove(x, y);
+        return;
+    }
+
+    // Otherwise only the widget under the mouse, plus the one it just left
+    Widget* widget = hitTest(x, y);
+    if (hoveredWidget && hoveredWidget != widget) {
+        hoveredWidget->handleMouseMove(x, y);
+    }
+    if (widget) {
+        widget->handleMouseMove(x, y);
+    }
+    hoveredWidget = widget;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include "Widget.h"
+#include <cstdint>
+#include <vector>
+
+class TextRenderer;
+
+// Retained layer for the widgets. They are drawn into one cached target
+// texture covering all of their bounds, and only widgets marked dirty are
+// cleared and redrawn, so an idle UI costs a single copy per frame.
+//
+// Mouse events are routed to one widget through a coarse grid over the
+// panel: cellStart[c] .. cellStart[c + 1] index the widgets overlapping cell
+// c (same layout as SpatialGrid). A pressed widget keeps receiving motion
+// and the release, so drags work outside its bounds.
+class UiPanel {
+public:
+    UiPanel();
+    ~UiPanel();
+
+    // Widgets are not owned, must not overlap and must all be added before
+    // initialize()
+    void addWidget(Widget* widget);
+
+    // Build the hit-test grid and the target texture
+    bool initialize(SDL_Renderer* renderer);
+    void cleanup();
+
+    // Route a mouse event; returns true if a widget received it
+    bool handleEvent(const SDL_Event& event);
+
+    // Redraw everything (e.g. after the renderer lost its targets)
+    void invalidate();
+
+    // Redraw dirty widgets and copy the panel to the screen. Flushes
+    // textRenderer, so call it before queuing other text
+    void render(SDL_Renderer* renderer, TextRenderer& textRenderer);
+
+private:
+    std::vector<Widget*> widgets;
+    SDL_Rect bounds;
+    SDL_Texture* target;  // Null if the renderer has no target support
+
+    // Hit-test grid over bounds
+    int gridWidth;
+    int gridHeight;
+    std::vector<uint32_t> cellStart;    // gridWidth * gridHeight + 1 offsets
+    std::vector<uint32_t> cellWidgets;  // Widget indices sorted by cell
+
+    Widget* activeWidget;   // Pressed widget, receives events until release
+    Widget* hoveredWidget;  // Last widget that got a motion event
+
+    void buildGrid();
+    Widget* hitTest(int x, int y) const;
+    void routeMotion(int x, int y);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+class TextRenderer;
+
+// Base for the widgets kept by UiPanel. A widget marks itself dirty whenever
+// something it draws changes (value, hover, press, label); the panel redraws
+// only dirty widgets into its cached texture.
+class Widget {
+public:
+    virtual ~Widget() = default;
+
+    // Handle mouse events
+    virtual void handleMouseDown(int mouseX, int mouseY) = 0;
+    virtual void handleMouseUp(int mouseX, int mouseY) = 0;
+    virtual void handleMouseMove(int mouseX, int mouseY) = 0;
+
+    // Draw the widget and queue its text, offset by -(originX, originY)
+    virtual void render(SDL_Renderer* renderer, TextRenderer& textRenderer, int originX, int originY) = 0;
+
+    // Area the widget draws in, including its label
+    virtual SDL_Rect getBounds() const = 0;
+
+    // Check if point is inside the interactive area
+    virtual bool containsPoint(int x, int y) const = 0;
+
+    bool isDirty() const { return dirty; }
+    void markDirty() { dirty = true; }
+    void clearDirty() { dirty = false; }
+
+protected:
+    bool dirty = true;
+};
@@ -0,0 +1,62 @@
+// Shrinks the container under a sleeping pile: the pile must wake and fall
+// instead of staying frozen where the old wall held it.
+
+#include "entities/BallStore.h"
+#include "entities/Container.h"
+#include "physics/PhysicsEngine.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+    constexpr float TIMESTEP = 1.0f / 120.0f;
+    constexpr float GRAVITY = 980.0f;
+    constexpr float RESTITUTION = 0.5f;
+    constexpr float BALL_RADIUS = 10.0f;
+    constexpr int MAX_SETTLE_STEPS = 2400;  // 20 s
+    constexpr int FALL_STEPS = 30;
+
+    bool check(bool condition, const char* message) {
+        if (!condition) {
+            std::cerr << "FAILED: " << message << std::endl;
+        }
+        return condition;
+    }
+}
+
+int main() {
+    Container container(Vector2D(400.0f, 400.0f), 300.0f, 18.0f);
+    PhysicsEngine physics(GRAVITY);
+    BallStore balls;
+
+    // A small pile resting on the bottom of the wall (the gap is on the right)
+    for (int i = 0; i < 5; ++i) {
+        float x = 360.0f + i * 2.0f * BALL_RADIUS;
+        balls.push(Ball(Vector2D(x, 680.0f), Vector2D(0.0f, 0.0f), BALL_RADIUS, Color{255, 255, 255, 255}));
+    }
+
+    int step = 0;
+    while (physics.getSleepingCount() < balls.size() && step < MAX_SETTLE_STEPS) {
+        physics.update(balls, container, TIMESTEP, RESTITUTION);
+        ++step;
+    }
+    if (!check(physics.getSleepingCount() == balls.size(), "pile did not fall asleep")) {
+        return EXIT_FAILURE;
+    }
+
+    // Shrink the wall well inside the pile
+    std::vector<float> restingY(balls.y.begin(), balls.y.end());
+    container.setRadius(200.0f);
+
+    physics.update(balls, container, TIMESTEP, RESTITUTION);
+    bool ok = check(physics.getSleepingCount() == 0, "pile still asleep after the container shrank");
+
+    for (int i = 0; i < FALL_STEPS; ++i) {
+        physics.update(balls, container, TIMESTEP, RESTITUTION);
+    }
+    for (size_t i = 0; i < balls.size(); ++i) {
+        ok &= check(balls.y[i] > restingY[i] + BALL_RADIUS, "ball stayed where the old wall held it");
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}